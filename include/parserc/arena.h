@@ -0,0 +1,181 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "combinator.h"
+
+namespace parsec {
+
+class arena;
+
+namespace detail {
+
+// the arena that the lists of pmr parsers of this thread use, if any.
+inline thread_local arena* current_arena = nullptr;
+
+}  // namespace detail
+
+// a bump allocator for the values of a parse, e.g. the lists of a syntax tree.
+// Allocation moves a pointer through blocks of memory, and the values of a whole
+// parse are freed at once by reset(), which keeps the blocks for the next parse.
+// Sizes are rounded up to powers of two and deallocated memory is reused for the
+// same size, so the buffers that lists outgrow are not wasted. While an arena is
+// alive the pmr parsers of its thread allocate from it. Arenas nest, the innermost
+// one is used.
+class arena : public std::pmr::memory_resource {
+ public:
+  // an arena whose first block has `block_size` bytes, later blocks double.
+  explicit arena(std::size_t block_size = 1 << 16)
+      : block_size_(std::max<std::size_t>(block_size, 64)), previous_(detail::current_arena) {
+    detail::current_arena = this;
+  }
+
+  arena(const arena&) = delete;
+  arena& operator=(const arena&) = delete;
+
+  ~arena() override {
+    detail::current_arena = previous_;
+  }
+
+  // frees every allocation, keeping the memory. The values allocated so far
+  // must not be used any more.
+  void reset() {
+    free_.fill(nullptr);
+    next_ = 0;
+    cursor_ = nullptr;
+    end_ = nullptr;
+  }
+
+  // the bytes of the blocks.
+  std::size_t capacity() const {
+    std::size_t ret = 0;
+    for (auto& b : blocks_) {
+      ret += b.size;
+    }
+    return ret;
+  }
+
+ private:
+  struct block {
+    std::unique_ptr<std::byte[]> data;
+    std::size_t size;
+  };
+
+  // the smallest size, and the alignment of the reused memory.
+  static constexpr std::size_t min_size = 16;
+
+  // the index of the free list of a size.
+  static std::size_t size_class(std::size_t bytes) {
+    return std::bit_width(std::max(bytes, min_size) - 1);
+  }
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    auto c = size_class(bytes);
+    if (alignment <= min_size && c < free_.size()) {
+      if (auto* p = free_[c]) {
+        free_[c] = *static_cast<void**>(p);
+        return p;
+      }
+      bytes = std::size_t{ 1 } << c;
+      alignment = std::min(bytes, min_size);
+    }
+
+    void* p = cursor_;
+    std::size_t space = end_ - cursor_;
+    while (std::align(alignment, bytes, p, space) == nullptr) {
+      next_block(bytes + alignment);
+      p = cursor_;
+      space = end_ - cursor_;
+    }
+    cursor_ = static_cast<std::byte*>(p) + bytes;
+    return p;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    auto c = size_class(bytes);
+    if (alignment <= min_size && c < free_.size()) {
+      *static_cast<void**>(p) = free_[c];
+      free_[c] = p;
+    }
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  // moves to the next block of at least `bytes` bytes, allocating it if needed.
+  void next_block(std::size_t bytes) {
+    for (; next_ < blocks_.size(); next_++) {
+      if (blocks_[next_].size >= bytes) {
+        break;
+      }
+    }
+    if (next_ == blocks_.size()) {
+      auto size = std::max(blocks_.empty() ? block_size_ : blocks_.back().size * 2, bytes);
+      blocks_.push_back({ std::make_unique_for_overwrite<std::byte[]>(size), size });
+    }
+    cursor_ = blocks_[next_].data.get();
+    end_ = cursor_ + blocks_[next_].size;
+    next_++;
+  }
+
+  std::size_t block_size_;
+  arena* previous_;
+  std::vector<block> blocks_;
+  std::array<void*, 32> free_{};
+  std::size_t next_ = 0;
+  std::byte* cursor_ = nullptr;
+  std::byte* end_ = nullptr;
+};
+
+// the memory resource of the values of a parse: the arena of this thread, or the
+// default resource without one. Functions that build their own lists, e.g. in a
+// map(), allocate from it too.
+inline std::pmr::memory_resource* arena_resource() {
+  if (detail::current_arena != nullptr) {
+    return detail::current_arena;
+  }
+  return std::pmr::get_default_resource();
+}
+
+namespace detail {
+
+template <typename T>
+struct list_traits<std::pmr::vector<T>> {
+  static std::pmr::vector<T> make() { return std::pmr::vector<T>(arena_resource()); }
+};
+
+}  // namespace detail
+
+// many, many1, sepby1 and sepby collecting the results into a std::pmr::vector
+// allocated from arena_resource(). They are not constexpr.
+namespace pmr {
+
+template <Parser P>
+constexpr auto many(P&& parser) {
+  return detail::collect_many<std::pmr::vector<invoke_parser_result_t<P>>>(parser);
+}
+
+template <Parser P>
+constexpr auto many1(P&& parser) {
+  return detail::collect_many1<std::pmr::vector<invoke_parser_result_t<P>>>(parser);
+}
+
+template <Parser P, Parser Sep>
+constexpr auto sepby1(P&& parser, Sep&& sep) {
+  return detail::collect_sepby1<std::pmr::vector<invoke_parser_result_t<P>>>(parser, sep);
+}
+
+template <Parser P, Parser Sep>
+constexpr auto sepby(P&& parser, Sep&& sep) {
+  return detail::collect_sepby<std::pmr::vector<invoke_parser_result_t<P>>>(parser, sep);
+}
+
+}  // namespace pmr
+
+}  // namespace parsec
\ No newline at end of file
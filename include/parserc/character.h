@@ -1,57 +1,162 @@
-#pragma once
-#include <algorithm>
-#include <ranges>
-
-#include "combinator.h"
-
-namespace parsec {
-
-// matches any char
-constexpr auto any() {
-  using R = ParserResult<char>;
-  return [](const Input& input) {
-    if (input.empty()) {
-      return R{ std::unexpect, "input is empty" };
-    }
-    return R{ { input.at(0), input.substr(1) } };
-  };
-};
-
-template <class F>
-constexpr auto satisfy(F&& f) {
-  return predict(any(), f);
-}
-
-template <char begin, char end>
-constexpr auto range = satisfy([](char c) {
-  return begin <= c && c <= end;
-});
-
-template <char... chs>
-constexpr auto one_of = satisfy([](char c) {
-  constexpr char arr[] = { chs... };
-  return std::ranges::contains(arr, c);
-});
-
-template <char... chs>
-constexpr auto none_of = satisfy([](char c) {
-  constexpr char arr[] = { chs... };
-  return !std::ranges::contains(arr, c);
-});
-
-constexpr auto digit = range<'0', '9'>;
-constexpr auto octdigit = range<'0', '7'>;
-constexpr auto hexdigit = range<'0', '9'> || range<'A', 'F'> || range<'a', 'f'>;
-constexpr auto lower = range<'a', 'z'>;
-constexpr auto upper = range<'A', 'Z'>;
-constexpr auto alpha = lower || upper;
-constexpr auto alphanum = alpha || digit;
-constexpr auto sign = one_of<'+', '-'>;
-constexpr auto space = one_of<' ', '\n', '\r', '\t'>;
-constexpr auto dot = one_of<'.'>;
-constexpr auto semi = one_of<';'>;
-constexpr auto comma = one_of<','>;
-constexpr auto colon = one_of<':'>;
-constexpr auto quota = one_of<'\"'>;
-
+#pragma once
+#include "combinator.h"
+#include "scan.h"
+
+namespace parsec {
+
+// matches any char
+constexpr auto any() {
+  using R = ParserResult<char>;
+  return [](const Input& input) {
+    if (input.empty()) {
+      return R{ std::unexpect, input, "input is empty" };
+    }
+    return R{ { input.at(0), input.substr(1) } };
+  };
+};
+
+template <class F>
+constexpr auto satisfy(F&& f) {
+  return predict(any(), f);
+}
+
+// matches characters while they satisfy a predicate, can be matched 0 times.
+// Return the matched slice of the input.
+template <class F>
+constexpr auto take_while(F&& f) {
+  using R = ParserResult<Input>;
+
+  return [f](const Input& input) {
+    std::size_t n = 0;
+    while (n < input.size() && f(input[n])) {
+      n++;
+    }
+    return R{ { input.substr(0, n), input.substr(n) } };
+  };
+}
+
+// matches characters while they satisfy a predicate at least one time.
+// Return the matched slice of the input.
+template <class F>
+constexpr auto take_while1(F&& f) {
+  using R = ParserResult<Input>;
+
+  return take_while(f) | and_then([](auto&& result) {
+    if (std::get<0>(result).empty()) {
+      return R{ std::unexpect, std::get<1>(result), "take_while1 dismatches." };
+    }
+    return R{ std::forward<decltype(result)>(result) };
+  });
+}
+
+// matches one character in a set of characters, looked up in a 256-bit table.
+template <charmap M>
+struct charset {
+  static constexpr charmap map = M;
+  static constexpr charmap first = M;
+  static constexpr bool nullable = false;
+
+  constexpr auto operator()(const Input& input) const {
+    using R = ParserResult<char>;
+    if (input.empty()) {
+      return R{ std::unexpect, input, "input is empty" };
+    }
+    if (!M.contains(input[0])) {
+      return R{ std::unexpect, input, "parser does not satisfy." };
+    }
+    return R{ { input[0], input.substr(1) } };
+  }
+};
+
+// choice between two sets of characters is the union of their tables.
+template <charmap M1, charmap M2>
+constexpr auto operator||(charset<M1>, charset<M2>) {
+  return charset<M1 | M2>{};
+}
+
+// matches characters in a set of characters, can be matched 0 times.
+// Return the matched slice of the input, scanned 16 or 32 characters at a time.
+template <charmap M>
+constexpr auto take_while(charset<M>) {
+  using R = ParserResult<Input>;
+
+  return [](const Input& input) {
+    auto n = scan<M>(input);
+    return R{ { input.substr(0, n), input.substr(n) } };
+  };
+}
+
+namespace detail {
+
+// many over a set of characters, collected from one scan of the input.
+template <charmap M>
+struct many_parser<std::vector<char>, charset<M>> {
+  using list_type = std::vector<char>;
+
+  charset<M> parser;
+
+  constexpr auto operator()(const Input& input) const {
+    using R = ParserResult<std::vector<char>>;
+    auto n = scan<M>(input);
+    return R{ { std::vector<char>(input.begin(), input.begin() + n), input.substr(n) } };
+  }
+};
+
+}  // namespace detail
+
+// many1 over a set of characters, collected from one scan of the input.
+template <charmap M>
+constexpr auto many1(charset<M> parser) {
+  using R = ParserResult<std::vector<char>>;
+
+  return detail::annotate<M, false>([parser](const Input& input) {
+    auto n = scan<M>(input);
+    if (n == 0) {
+      return R{ std::unexpect, parser(input).error() };
+    }
+    return R{ { std::vector<char>(input.begin(), input.begin() + n), input.substr(n) } };
+  });
+}
+
+// count over a set of characters, the length of one scan of the input.
+template <charmap M>
+constexpr auto count(charset<M>) {
+  using R = ParserResult<std::size_t>;
+
+  return [](const Input& input) {
+    auto n = scan<M>(input);
+    return R{ { n, input.substr(n) } };
+  };
+}
+
+// skip_many over a set of characters, same as take_while.
+template <charmap M>
+constexpr auto skip_many(charset<M> parser) {
+  return take_while(parser);
+}
+
+template <char begin, char end>
+constexpr auto range = charset<charmap::range(begin, end)>{};
+
+template <char... chs>
+constexpr auto one_of = charset<charmap::of(chs...)>{};
+
+template <char... chs>
+constexpr auto none_of = charset<~charmap::of(chs...)>{};
+
+constexpr auto digit = range<'0', '9'>;
+constexpr auto octdigit = range<'0', '7'>;
+constexpr auto hexdigit = range<'0', '9'> || range<'A', 'F'> || range<'a', 'f'>;
+constexpr auto lower = range<'a', 'z'>;
+constexpr auto upper = range<'A', 'Z'>;
+constexpr auto alpha = lower || upper;
+constexpr auto alphanum = alpha || digit;
+constexpr auto sign = one_of<'+', '-'>;
+constexpr auto space = one_of<' ', '\n', '\r', '\t'>;
+constexpr auto dot = one_of<'.'>;
+constexpr auto semi = one_of<';'>;
+constexpr auto comma = one_of<','>;
+constexpr auto colon = one_of<':'>;
+constexpr auto quota = one_of<'\"'>;
+
 }  // namespace parsec
\ No newline at end of file
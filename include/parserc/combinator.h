@@ -1,228 +1,821 @@
-#pragma once
-#include <array>
-#include <vector>
-
-#include "monadic.h"
-
-namespace parsec {
-
-// consumes no input and always succeeds with given value.
-template <typename V, typename... Args>
-  requires std::is_constructible_v<V, Args...>
-constexpr auto success(Args&&... args) {
-  return [=](const Input& input) -> ParserResult<V> {
-    return { { V(std::forward<Args>(args)...), input } };
-  };
-}
-
-// return the result of the parser if it satisfies a function.
-template <Parser P, typename F>
-  requires std::predicate<F, invoke_parser_result_t<P>>
-constexpr auto predict(P&& parser, F&& f) {
-  using R = ParserResult<invoke_parser_result_t<P>>;
-
-  return parser | and_then([f](auto&& result) {
-    auto&& [value, rest] = result;
-    if (f(value)) {
-      return R{ result };
-    }
-    return R{ std::unexpect, "parser does not satisfy." };
-  });
-}
-
-// matches a sequence of parsers in the defined order.
-template <Parser P1, Parser P2>
-constexpr auto seq(P1&& parser1, P2&& parser2) {
-  using V1 = invoke_parser_result_t<P1>;
-  using V2 = invoke_parser_result_t<P2>;
-  using R = Output<std::tuple<V1, V2>>;
-
-  return parser1 | and_then([parser2](auto&& result) {
-    auto&& [value1, rest] = result;
-    return parser2(rest).map([value1](auto&& result) {
-      auto&& [value2, rest] = result;
-      return R{ { value1, value2 }, rest };
-    });
-  });
-}
-
-// operator for seq.
-template <Parser P1, Parser P2>
-constexpr auto operator+(P1&& parser1, P2&& parser2) {
-  return seq(parser1, parser2);
-}
-
-// tries to apply the parsers in order until one of them succeeds.
-template <Parser P1, Parser P2>
-  requires std::same_as<invoke_parser_result_t<P1>, invoke_parser_result_t<P2>>
-constexpr auto choice(P1&& parser1, P2&& parser2) {
-  return [parser1, parser2](const Input& input) {
-    return parser1(input).or_else([parser2, input]() {
-      return parser2(input);
-    });
-  };
-}
-
-// operator for choice.
-template <Parser P1, Parser P2>
-constexpr auto operator||(P1&& parser1, P2&& parser2) {
-  return choice(parser1, parser2);
-}
-
-// matches two parsers and accepts the result from the left side.
-template <Parser P1, Parser P2>
-constexpr auto left(P1&& parser1, P2&& parser2) {
-  return (parser1 + parser2) | map([](auto&& result) {
-    return std::get<0>(result);
-  });
-}
-
-// matches two parsers and accepts the result from the right side.
-template <Parser P1, Parser P2>
-constexpr auto right(P1&& parser1, P2&& parser2) {
-  return (parser1 + parser2) | map([](auto&& result) {
-    return std::get<1>(result);
-  });
-}
-
-// matches three parsers and accepts the result from the middle one.
-template <Parser P1, Parser P2, Parser P3>
-constexpr auto between(P1&& parser1, P2&& parser2, P3&& parser3) {
-  return (parser1 + parser2 + parser3) | map([](auto&& result) {
-    return std::get<1>(std::get<0>(result));
-  });
-}
-
-// matches a parser multiple times, can be a matched 0 times.
-template <Parser P>
-constexpr auto many(P&& parser) {
-  using V = invoke_parser_result_t<P>;
-  using R = ParserResult<std::vector<V>>;
-
-  return [parser](const Input& input) {
-    Input rest = input;
-    std::vector<V> list;
-    while (auto result = parser(rest)) {
-      if (!result.has_value()) {
-        break;
-      }
-
-      rest = std::get<1>(result.value());
-      list.emplace_back(std::get<0>(result.value()));
-    }
-    return R{ { list, rest } };
-  };
-}
-
-// matches a parser in a fixed amount of times.
-template <std::size_t N, Parser P>
-constexpr auto many(P&& parser) {
-  using V = invoke_parser_result_t<P>;
-  using R = ParserResult<std::array<V, N>>;
-
-  return [parser](const Input& input) {
-    Input rest = input;
-    std::array<V, N> ret;
-    for (std::size_t i = 0; i < N; i++) {
-      auto result = parser(rest);
-      if (!result.has_value()) {
-        return R{ std::unexpect, "many<> dismatches." };
-      }
-
-      rest = std::get<1>(result.value());
-      ret[i] = std::get<0>(result.value());
-    }
-    return R{ { ret, rest } };
-  };
-}
-
-// matches a parser multiple times at least one time.
-template <Parser P>
-constexpr auto many1(P&& parser) {
-  using V = invoke_parser_result_t<P>;
-
-  return (parser + many(parser)) | map([](auto&& result) {
-    auto&& [first, others] = result;
-
-    std::vector<V> ret;
-    ret.reserve(others.size() + 1);
-    ret.insert(ret.end(), first);
-    ret.insert(ret.end(), others.begin(), others.end());
-    return ret;
-  });
-}
-
-// matches a parser separated by another parser at lease one time.
-template <Parser P, Parser Sep>
-constexpr auto sepby1(P&& parser, Sep&& sep) {
-  using V = invoke_parser_result_t<P>;
-
-  return (parser + many(sep + parser)) | map([](auto&& result) {
-    auto&& [first, others] = result;
-
-    std::vector<V> ret;
-    ret.reserve(others.size() + 1);
-    ret.emplace_back(first);
-    for (auto& [_, other] : others) {
-      ret.emplace_back(other);
-    }
-    return ret;
-  });
-}
-
-// matches a parser separated by another parser, can be a matched 0 times.
-template <Parser P, Parser Sep>
-constexpr auto sepby(P&& parser, Sep&& sep) {
-  using R = std::vector<invoke_parser_result_t<P>>;
-
-  return sepby1(parser, sep) || success<R>();
-}
-
-// matches a parser separated by another parser in a fixed amount of times.
-template <std::size_t N, Parser P, Parser Sep>
-constexpr auto sepby(P&& parser, Sep&& sep) {
-  using V = invoke_parser_result_t<P>;
-  using R = ParserResult<std::array<V, N>>;
-
-  return [parser, sep](const Input& input) {
-    Input rest = input;
-    std::array<V, N> ret;
-    for (std::size_t i = 0; i < N; i++) {
-      if (i != 0) {
-        auto result = sep(rest);
-        if (!result.has_value()) {
-          return R{ std::unexpect, "sepby<> mismatches sep." };
-        }
-        rest = std::get<1>(result.value());
-      }
-
-      auto result = parser(rest);
-      if (!result.has_value()) {
-        return R{ std::unexpect, "sepby<> mismatches parser." };
-      }
-
-      rest = std::get<1>(result.value());
-      ret[i] = std::get<0>(result.value());
-    }
-
-    return R{ { ret, rest } };
-  };
-}
-
-// matches the end of the input.
-template <Parser P>
-constexpr auto eof(P&& parser) {
-  using R = ParserResult<invoke_parser_result_t<P>>;
-
-  return [parser](const Input& input) {
-    auto result = parser(input);
-    if (result.has_value()) {
-      if (!std::get<1>(result.value()).empty()) {
-        return R{ std::unexpect, "not end of input" };
-      }
-    }
-    return result;
-  };
-}
-
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "monadic.h"
+
+namespace parsec {
+
+namespace detail {
+
+// matches a parser repeatedly and folds the results into acc with f(acc, value).
+// Return the rest of the input after the last match, or a committed failure.
+template <Parser P, typename T, typename F>
+constexpr Result<Input> fold(const P& parser, T& acc, const F& f, Input rest) {
+  while (true) {
+    auto result = parser(rest);
+    if (!result.has_value()) {
+      if (result.error().committed) {
+        return Result<Input>{ std::unexpect, result.error() };
+      }
+      return rest;
+    }
+    rest = std::get<1>(result.value());
+    acc = std::invoke(f, std::move(acc), std::get<0>(std::move(result).value()));
+  }
+}
+
+// a new empty list for the results of many and sepby. Lists with an allocator
+// of their own specialize it, see arena.h.
+template <typename List>
+struct list_traits {
+  static constexpr List make() { return List(); }
+};
+
+// matches a parser repeatedly and appends the results to a list.
+// Return the rest of the input after the last match, or a committed failure.
+template <Parser P, typename List>
+constexpr Result<Input> append(const P& parser, List& list, Input rest) {
+  while (true) {
+    auto result = parser(rest);
+    if (!result.has_value()) {
+      if (result.error().committed) {
+        return Result<Input>{ std::unexpect, result.error() };
+      }
+      return rest;
+    }
+    rest = std::get<1>(result.value());
+    list.emplace_back(std::get<0>(std::move(result).value()));
+  }
+}
+
+// matches a parser repeatedly and collects the results into a List, see many.
+template <typename List, typename P>
+struct many_parser {
+  using list_type = List;
+
+  P parser;
+
+  constexpr auto operator()(const Input& input) const {
+    using R = ParserResult<List>;
+    List list = list_traits<List>::make();
+    auto rest = append(parser, list, input);
+    if (!rest.has_value()) {
+      return R{ std::unexpect, rest.error() };
+    }
+    return R{ { std::move(list), rest.value() } };
+  }
+};
+
+// matches the first parser and then the next parser multiple times,
+// collecting the results into a List.
+template <typename List, Parser P, Parser N>
+constexpr auto collect1(P&& first, N&& next) {
+  using R = ParserResult<List>;
+
+  return [first, next](const Input& input) {
+    auto result = first(input);
+    if (!result.has_value()) {
+      return R{ std::unexpect, result.error() };
+    }
+
+    List list = list_traits<List>::make();
+    list.emplace_back(std::get<0>(std::move(result).value()));
+    auto rest = append(next, list, std::get<1>(result.value()));
+    if (!rest.has_value()) {
+      return R{ std::unexpect, rest.error() };
+    }
+    return R{ { std::move(list), rest.value() } };
+  };
+}
+
+// a parser with a declared first set, see first_set.
+template <typename P, charmap First, bool Nullable>
+struct annotated {
+  static constexpr charmap first = First;
+  static constexpr bool nullable = Nullable;
+
+  P parser;
+
+  constexpr auto operator()(const Input& input) const {
+    return parser(input);
+  }
+};
+
+template <charmap First, bool Nullable, Parser P>
+constexpr auto annotate(P&& parser) {
+  return annotated<std::decay_t<P>, First, Nullable>{ std::forward<P>(parser) };
+}
+
+// an ordered choice between the parsers. Each alternative whose first set
+// excludes the next character is skipped, the rest are tried in order.
+template <Parser... Ps>
+struct choice_parser {
+  static constexpr charmap first = (first_v<Ps> | ...);
+  static constexpr bool nullable = (nullable_v<Ps> || ...);
+
+  std::tuple<Ps...> parsers;
+
+  constexpr auto operator()(const Input& input) const {
+    using R = std::invoke_result_t<std::tuple_element_t<0, std::tuple<Ps...>>, Input>;
+
+    auto mask = candidates[input.empty() ? 256 : static_cast<unsigned char>(input[0])];
+    if (mask == 0) {
+      return R{ std::unexpect, input, "choice dismatches." };
+    }
+    if ((mask & (mask - 1)) == 0) {
+      return call(std::countr_zero(mask), input);
+    }
+
+    // keeps the furthest failure of the alternatives, or stops at a committed one.
+    auto result = call(std::countr_zero(mask), input);
+    for (mask &= mask - 1; !result.has_value() && !result.error().committed && mask != 0; mask &= mask - 1) {
+      auto next = call(std::countr_zero(mask), input);
+      if (next.has_value() || next.error().committed || &furthest(result.error(), next.error()) == &next.error()) {
+        result = std::move(next);
+      }
+    }
+    return result;
+  }
+
+ private:
+  // the alternatives that can match an input starting with each character,
+  // as bitmasks, and the nullable ones at 256 for the empty input.
+  static constexpr auto candidates = [] {
+    constexpr std::array<charmap, sizeof...(Ps)> firsts{ first_v<Ps>... };
+    constexpr std::array<bool, sizeof...(Ps)> nullables{ nullable_v<Ps>... };
+
+    std::array<std::uint64_t, 257> ret{};
+    for (std::size_t i = 0; i < sizeof...(Ps); i++) {
+      for (int c = 0; c < 256; c++) {
+        if (nullables[i] || firsts[i].contains(static_cast<char>(c))) {
+          ret[c] |= std::uint64_t{ 1 } << i;
+        }
+      }
+      if (nullables[i]) {
+        ret[256] |= std::uint64_t{ 1 } << i;
+      }
+    }
+    return ret;
+  }();
+
+  // calls the i-th alternative, compiled to a jump table or a chain of compares.
+  template <std::size_t I = 0>
+  constexpr auto call(std::size_t i, const Input& input) const {
+    if constexpr (I + 1 < sizeof...(Ps)) {
+      if (i != I) {
+        return call<I + 1>(i, input);
+      }
+    }
+    return std::get<I>(parsers)(input);
+  }
+};
+
+template <typename P>
+struct is_choice_parser : std::false_type {};
+
+template <typename... Ps>
+struct is_choice_parser<choice_parser<Ps...>> : std::true_type {};
+
+// the alternatives of a parser, flattened if it is a choice itself.
+template <Parser P>
+constexpr auto alternatives(P&& parser) {
+  if constexpr (is_choice_parser<std::remove_cvref_t<P>>::value) {
+    return std::forward<P>(parser).parsers;
+  } else {
+    return std::tuple<std::decay_t<P>>{ std::forward<P>(parser) };
+  }
+}
+
+template <typename... Ps>
+constexpr auto make_choice(std::tuple<Ps...> parsers) {
+  return choice_parser<Ps...>{ std::move(parsers) };
+}
+
+// the most alternatives dispatched by one table.
+inline constexpr std::size_t max_alternatives = 64;
+
+// a parser whose value is discarded by a sequence, see skip.
+template <typename P>
+struct skipped {
+  static constexpr charmap first = first_v<P>;
+  static constexpr bool nullable = nullable_v<P>;
+
+  P parser;
+
+  constexpr auto operator()(const Input& input) const {
+    return parser(input);
+  }
+};
+
+template <typename P>
+struct is_skipped : std::false_type {};
+
+template <typename P>
+struct is_skipped<skipped<P>> : std::true_type {};
+
+// a parser of a tuple whose values a sequence keeps one by one, as if they were
+// the values of a sequence in its place. Used by optimize.
+template <typename P>
+struct spliced {
+  static constexpr charmap first = first_v<P>;
+  static constexpr bool nullable = nullable_v<P>;
+
+  P parser;
+
+  constexpr auto operator()(const Input& input) const {
+    return parser(input);
+  }
+};
+
+template <typename P>
+struct is_spliced : std::false_type {};
+
+template <typename P>
+struct is_spliced<spliced<P>> : std::true_type {};
+
+// a parser returning the slice of the input it matched, see slice.
+template <typename P>
+struct sliced {
+  static constexpr charmap first = first_v<P>;
+  static constexpr bool nullable = nullable_v<P>;
+
+  P parser;
+
+  constexpr auto operator()(const Input& input) const {
+    using R = ParserResult<Input>;
+    auto result = parser(input);
+    if (!result.has_value()) {
+      return R{ std::unexpect, result.error() };
+    }
+    auto rest = std::get<1>(result.value());
+    return R{ { input.substr(0, input.size() - rest.size()), rest } };
+  }
+};
+
+// a parser whose failures are committed, see commit.
+template <typename P>
+struct committed {
+  static constexpr charmap first = first_v<P>;
+  static constexpr bool nullable = nullable_v<P>;
+
+  P parser;
+
+  constexpr auto operator()(const Input& input) const {
+    auto result = parser(input);
+    if (!result.has_value()) {
+      result.error().committed = true;
+    }
+    return result;
+  }
+};
+
+// a parser whose committed failures can be backtracked from, see attempt.
+template <typename P>
+struct attempted {
+  static constexpr charmap first = first_v<P>;
+  static constexpr bool nullable = nullable_v<P>;
+
+  P parser;
+
+  constexpr auto operator()(const Input& input) const {
+    auto result = parser(input);
+    if (!result.has_value()) {
+      result.error().committed = false;
+    }
+    return result;
+  }
+};
+
+// the values a parser keeps in a sequence: none, its value, or the values of the
+// tuple it returns, which are spliced.
+template <typename P>
+struct kept_values {
+  using type = std::tuple<invoke_parser_result_t<P>>;
+};
+
+template <typename P>
+struct kept_values<skipped<P>> {
+  using type = std::tuple<>;
+};
+
+template <typename P>
+struct kept_values<spliced<P>> {
+  using type = invoke_parser_result_t<P>;
+};
+
+// the value of a sequence: a tuple of the values it keeps, or the value itself
+// if it keeps one.
+template <typename Values>
+struct seq_value {
+  using type = Values;
+};
+
+template <typename V>
+struct seq_value<std::tuple<V>> {
+  using type = V;
+};
+
+// a sequence of parsers matched in order. The value of each parser stays in the
+// result of its call until the last one has matched, and then is moved once into
+// the value of the sequence, whatever the length of the sequence.
+template <Parser... Ps>
+struct seq_parser {
+  // a parser can only start the match if the ones before it can be empty.
+  static constexpr charmap first = [] {
+    constexpr std::array<charmap, sizeof...(Ps)> firsts{ first_v<Ps>... };
+    constexpr std::array<bool, sizeof...(Ps)> nullables{ nullable_v<Ps>... };
+
+    charmap ret;
+    for (std::size_t i = 0; i < sizeof...(Ps); i++) {
+      ret = ret | firsts[i];
+      if (!nullables[i]) {
+        break;
+      }
+    }
+    return ret;
+  }();
+  static constexpr bool nullable = (nullable_v<Ps> && ...);
+
+  // the values kept, and the value of the sequence.
+  using values_type = decltype(std::tuple_cat(std::declval<typename kept_values<Ps>::type>()...));
+  using value_type = seq_value<values_type>::type;
+
+  std::tuple<Ps...> parsers;
+
+  constexpr auto operator()(const Input& input) const {
+    return call<0>(input);
+  }
+
+ private:
+  using R = ParserResult<value_type>;
+
+  // calls the I-th parser with the values kept so far.
+  template <std::size_t I, typename... Vs>
+  constexpr R call(const Input& input, Vs&... values) const {
+    if constexpr (I == sizeof...(Ps)) {
+      if constexpr (sizeof...(Vs) == 1) {
+        return R{ { std::move(values)..., input } };
+      } else {
+        return R{ { value_type{ std::move(values)... }, input } };
+      }
+    } else {
+      auto result = std::get<I>(parsers)(input);
+      if (!result.has_value()) {
+        return R{ std::unexpect, result.error() };
+      }
+
+      // the values kept tell whether the value is dropped, kept or spliced.
+      auto& [value, rest] = result.value();
+      using Kept = kept_values<std::tuple_element_t<I, std::tuple<Ps...>>>::type;
+      if constexpr (std::tuple_size_v<Kept> == 0) {
+        return call<I + 1>(rest, values...);
+      } else if constexpr (std::same_as<Kept, std::tuple<std::remove_cvref_t<decltype(value)>>>) {
+        return call<I + 1>(rest, values..., value);
+      } else {
+        return std::apply([&](auto&... spliced) {
+          return call<I + 1>(rest, values..., spliced...);
+        }, value);
+      }
+    }
+  }
+};
+
+template <typename P>
+struct is_seq_parser : std::false_type {};
+
+template <typename... Ps>
+struct is_seq_parser<seq_parser<Ps...>> : std::true_type {};
+
+// the parsers of a sequence, flattened if it is a sequence itself.
+template <Parser P>
+constexpr auto elements(P&& parser) {
+  if constexpr (is_seq_parser<std::remove_cvref_t<P>>::value) {
+    return std::forward<P>(parser).parsers;
+  } else {
+    return std::tuple<std::decay_t<P>>{ std::forward<P>(parser) };
+  }
+}
+
+template <typename... Ps>
+constexpr auto make_seq(std::tuple<Ps...> parsers) {
+  return seq_parser<Ps...>{ std::move(parsers) };
+}
+
+}  // namespace detail
+
+// consumes no input and always succeeds with given value.
+template <typename V, typename... Args>
+  requires std::is_constructible_v<V, Args...>
+constexpr auto success(Args&&... args) {
+  return [=](const Input& input) -> ParserResult<V> {
+    return { { V(std::forward<Args>(args)...), input } };
+  };
+}
+
+// return the result of the parser if it satisfies a function.
+template <Parser P, typename F>
+  requires std::predicate<F, invoke_parser_result_t<P>>
+constexpr auto predict(P&& parser, F&& f) {
+  using R = ParserResult<invoke_parser_result_t<P>>;
+
+  return detail::annotate<first_v<P>, nullable_v<P>>([parser, f](const Input& input) {
+    auto result = parser(input);
+    if (result.has_value() && !f(std::get<0>(result.value()))) {
+      return R{ std::unexpect, input, "parser does not satisfy." };
+    }
+    return result;
+  });
+}
+
+// marks a parser whose value is discarded by the sequences it is in,
+// e.g. seq(skip(one_of<'('>), digit, skip(one_of<')'>)) returns the digit.
+template <Parser P>
+constexpr auto skip(P&& parser) {
+  return detail::skipped<std::decay_t<P>>{ std::forward<P>(parser) };
+}
+
+// matches a parser and returns the slice of the input it matched instead of its
+// value, e.g. slice(one_of<'Z'>) || slice(sign + digit + digit) to choose between
+// parsers of different values.
+template <Parser P>
+constexpr auto slice(P&& parser) {
+  return detail::sliced<std::decay_t<P>>{ std::forward<P>(parser) };
+}
+
+// matches a parser and commits to the alternative it is in, a cut: if it fails,
+// the enclosing choices fail without trying their other alternatives, and the
+// enclosing repetitions fail instead of stopping, up to the nearest attempt.
+// It goes after the prefix that decides an alternative, e.g.
+// seq(skip(lit<"GET ">), commit(request)) || seq(skip(lit<"POST ">), commit(request)),
+// so a malformed request is reported where it fails, not retried as a POST.
+template <Parser P>
+constexpr auto commit(P&& parser) {
+  return detail::committed<std::decay_t<P>>{ std::forward<P>(parser) };
+}
+
+// matches a parser and backtracks from its failures even if they are committed,
+// the try of Parsec: a commit inside it only cuts the choices inside it.
+template <Parser P>
+constexpr auto attempt(P&& parser) {
+  return detail::attempted<std::decay_t<P>>{ std::forward<P>(parser) };
+}
+
+// matches a sequence of parsers in the defined order. Return a flat std::tuple of
+// the values of the parsers that are not skipped, or the value itself if there is
+// only one. Sequences among the parsers are flattened, so a + b + c returns a
+// std::tuple of three values.
+template <Parser... Ps>
+  requires(sizeof...(Ps) >= 2)
+constexpr auto seq(Ps&&... parsers) {
+  return detail::make_seq(std::tuple_cat(detail::elements(std::forward<Ps>(parsers))...));
+}
+
+// operator for seq.
+template <Parser P1, Parser P2>
+constexpr auto operator+(P1&& parser1, P2&& parser2) {
+  return seq(std::forward<P1>(parser1), std::forward<P2>(parser2));
+}
+
+// tries to apply the parsers in order until one of them succeeds.
+template <Parser P1, Parser P2>
+  requires std::same_as<invoke_parser_result_t<P1>, invoke_parser_result_t<P2>>
+constexpr auto choice(P1&& parser1, P2&& parser2) {
+  using A1 = decltype(detail::alternatives(std::declval<P1>()));
+  using A2 = decltype(detail::alternatives(std::declval<P2>()));
+
+  if constexpr (std::tuple_size_v<A1> + std::tuple_size_v<A2> <= detail::max_alternatives) {
+    return detail::make_choice(std::tuple_cat(detail::alternatives(std::forward<P1>(parser1)),
+                                              detail::alternatives(std::forward<P2>(parser2))));
+  } else {
+    return detail::make_choice(std::tuple<std::decay_t<P1>, std::decay_t<P2>>{
+        std::forward<P1>(parser1), std::forward<P2>(parser2) });
+  }
+}
+
+// operator for choice.
+template <Parser P1, Parser P2>
+constexpr auto operator||(P1&& parser1, P2&& parser2) {
+  return choice(parser1, parser2);
+}
+
+// matches two parsers and accepts the result from the left side.
+template <Parser P1, Parser P2>
+constexpr auto left(P1&& parser1, P2&& parser2) {
+  return seq(std::forward<P1>(parser1), skip(std::forward<P2>(parser2)));
+}
+
+// matches two parsers and accepts the result from the right side.
+template <Parser P1, Parser P2>
+constexpr auto right(P1&& parser1, P2&& parser2) {
+  return seq(skip(std::forward<P1>(parser1)), std::forward<P2>(parser2));
+}
+
+// matches three parsers and accepts the result from the middle one.
+template <Parser P1, Parser P2, Parser P3>
+constexpr auto between(P1&& parser1, P2&& parser2, P3&& parser3) {
+  return seq(skip(std::forward<P1>(parser1)), std::forward<P2>(parser2), skip(std::forward<P3>(parser3)));
+}
+
+namespace detail {
+
+// many, many1, sepby1 and sepby collecting the results into a List.
+template <typename List, Parser P>
+constexpr auto collect_many(P&& parser) {
+  return many_parser<List, std::decay_t<P>>{ std::forward<P>(parser) };
+}
+
+template <typename List, Parser P>
+constexpr auto collect_many1(P&& parser) {
+  return annotate<first_v<P>, nullable_v<P>>(collect1<List>(parser, parser));
+}
+
+template <typename List, Parser P, Parser Sep>
+constexpr auto collect_sepby1(P&& parser, Sep&& sep) {
+  return annotate<first_v<P>, nullable_v<P>>(collect1<List>(parser, right(sep, parser)));
+}
+
+// a function or an output iterator the results are passed to one by one.
+template <typename S, typename V>
+concept sink_of = std::invocable<S&, V> || std::output_iterator<S, V>;
+
+template <typename S, typename V>
+constexpr void emit(S& sink, V&& value) {
+  if constexpr (std::invocable<S&, V>) {
+    std::invoke(sink, std::forward<V>(value));
+  } else {
+    *sink++ = std::forward<V>(value);
+  }
+}
+
+// matches the first parser and then the next parser multiple times, passing the
+// results to a copy of the sink. Return the number of results.
+template <bool Once, Parser P, Parser N, typename S>
+constexpr auto emit_many(P&& first, N&& next, S&& sink) {
+  using R = ParserResult<std::size_t>;
+
+  return [first, next, sink](const Input& input) {
+    auto out = sink;
+    auto result = first(input);
+    if (!result.has_value()) {
+      if (Once || result.error().committed) {
+        return R{ std::unexpect, result.error() };
+      }
+      return R{ { 0, input } };
+    }
+
+    Input rest = std::get<1>(result.value());
+    emit(out, std::get<0>(std::move(result).value()));
+    std::size_t n = 1;
+    while (true) {
+      auto result = next(rest);
+      if (!result.has_value()) {
+        if (result.error().committed) {
+          return R{ std::unexpect, result.error() };
+        }
+        return R{ { n, rest } };
+      }
+      rest = std::get<1>(result.value());
+      emit(out, std::get<0>(std::move(result).value()));
+      n++;
+    }
+  };
+}
+
+template <typename List, Parser P, Parser Sep>
+constexpr auto collect_sepby(P&& parser, Sep&& sep) {
+  return collect_sepby1<List>(parser, sep) || [](const Input& input) {
+    return ParserResult<List>{ { list_traits<List>::make(), input } };
+  };
+}
+
+}  // namespace detail
+
+// matches a parser multiple times, can be a matched 0 times.
+template <Parser P>
+constexpr auto many(P&& parser) {
+  return detail::collect_many<std::vector<invoke_parser_result_t<P>>>(parser);
+}
+
+// matches a parser multiple times collecting the results into a List, e.g. a
+// small_vector for short repetitions, can be a matched 0 times.
+template <typename List, Parser P>
+constexpr auto many(P&& parser) {
+  return detail::collect_many<List>(parser);
+}
+
+// matches a parser in a fixed amount of times.
+template <std::size_t N, Parser P>
+constexpr auto many(P&& parser) {
+  using V = invoke_parser_result_t<P>;
+  using R = ParserResult<std::array<V, N>>;
+
+  return detail::annotate<first_v<P>, N == 0 || nullable_v<P>>([parser](const Input& input) {
+    Input rest = input;
+    std::array<V, N> ret;
+    for (std::size_t i = 0; i < N; i++) {
+      auto result = parser(rest);
+      if (!result.has_value()) {
+        if (result.error().committed) {
+          return R{ std::unexpect, result.error() };
+        }
+        return R{ std::unexpect, rest, "many<> dismatches." };
+      }
+
+      rest = std::get<1>(result.value());
+      ret[i] = std::get<0>(std::move(result).value());
+    }
+    return R{ { std::move(ret), rest } };
+  });
+}
+
+// matches a parser multiple times and folds the results into an accumulator
+// with f(acc, value), can be matched 0 times.
+template <Parser P, typename T, typename F>
+  requires std::is_invocable_r_v<T, F, T, invoke_parser_result_t<P>>
+constexpr auto fold_many(P&& parser, T init, F&& f) {
+  using R = ParserResult<T>;
+
+  return [parser, init, f](const Input& input) {
+    T acc = init;
+    auto rest = detail::fold(parser, acc, f, input);
+    if (!rest.has_value()) {
+      return R{ std::unexpect, rest.error() };
+    }
+    return R{ { std::move(acc), rest.value() } };
+  };
+}
+
+// matches a parser multiple times at least one time and folds the results
+// into an accumulator with f(acc, value).
+template <Parser P, typename T, typename F>
+  requires std::is_invocable_r_v<T, F, T, invoke_parser_result_t<P>>
+constexpr auto fold_many1(P&& parser, T init, F&& f) {
+  using R = ParserResult<T>;
+
+  return detail::annotate<first_v<P>, nullable_v<P>>([parser, init, f](const Input& input) {
+    auto result = parser(input);
+    if (!result.has_value()) {
+      return R{ std::unexpect, result.error() };
+    }
+
+    T acc = std::invoke(f, T(init), std::get<0>(std::move(result).value()));
+    auto rest = detail::fold(parser, acc, f, std::get<1>(result.value()));
+    if (!rest.has_value()) {
+      return R{ std::unexpect, rest.error() };
+    }
+    return R{ { std::move(acc), rest.value() } };
+  });
+}
+
+// matches a parser multiple times and counts the matches, can be matched 0 times.
+template <Parser P>
+constexpr auto count(P&& parser) {
+  return fold_many(parser, std::size_t{ 0 }, [](std::size_t n, auto&&) {
+    return n + 1;
+  });
+}
+
+// matches a parser multiple times and discards the results, can be matched 0 times.
+// Return the skipped slice of the input.
+template <Parser P>
+constexpr auto skip_many(P&& parser) {
+  using R = ParserResult<Input>;
+
+  return [parser](const Input& input) {
+    Input rest = input;
+    while (true) {
+      auto result = parser(rest);
+      if (!result.has_value()) {
+        if (result.error().committed) {
+          return R{ std::unexpect, result.error() };
+        }
+        return R{ { input.substr(0, input.size() - rest.size()), rest } };
+      }
+      rest = std::get<1>(result.value());
+    }
+  };
+}
+
+// matches a parser multiple times at least one time.
+template <Parser P>
+constexpr auto many1(P&& parser) {
+  return detail::collect_many1<std::vector<invoke_parser_result_t<P>>>(parser);
+}
+
+// many1 collecting the results into a List.
+template <typename List, Parser P>
+constexpr auto many1(P&& parser) {
+  return detail::collect_many1<List>(parser);
+}
+
+// matches a parser separated by another parser at lease one time.
+template <Parser P, Parser Sep>
+constexpr auto sepby1(P&& parser, Sep&& sep) {
+  return detail::collect_sepby1<std::vector<invoke_parser_result_t<P>>>(parser, sep);
+}
+
+// sepby1 collecting the results into a List.
+template <typename List, Parser P, Parser Sep>
+constexpr auto sepby1(P&& parser, Sep&& sep) {
+  return detail::collect_sepby1<List>(parser, sep);
+}
+
+// matches a parser separated by another parser, can be a matched 0 times.
+template <Parser P, Parser Sep>
+constexpr auto sepby(P&& parser, Sep&& sep) {
+  return detail::collect_sepby<std::vector<invoke_parser_result_t<P>>>(parser, sep);
+}
+
+// sepby collecting the results into a List.
+template <typename List, Parser P, Parser Sep>
+constexpr auto sepby(P&& parser, Sep&& sep) {
+  return detail::collect_sepby<List>(parser, sep);
+}
+
+// many, many1, sepby and sepby1 passing each result to a sink as soon as it is
+// parsed instead of collecting them, so the memory does not grow with the matches.
+// The sink is a function or an output iterator, copied at each parse, so functions
+// should refer to their state. Return the number of results.
+template <Parser P, typename Sink>
+  requires detail::sink_of<std::decay_t<Sink>, invoke_parser_result_t<P>>
+constexpr auto many_into(P&& parser, Sink&& sink) {
+  return detail::emit_many<false>(parser, parser, sink);
+}
+
+template <Parser P, typename Sink>
+  requires detail::sink_of<std::decay_t<Sink>, invoke_parser_result_t<P>>
+constexpr auto many1_into(P&& parser, Sink&& sink) {
+  return detail::annotate<first_v<P>, nullable_v<P>>(detail::emit_many<true>(parser, parser, sink));
+}
+
+template <Parser P, Parser Sep, typename Sink>
+  requires detail::sink_of<std::decay_t<Sink>, invoke_parser_result_t<P>>
+constexpr auto sepby_into(P&& parser, Sep&& sep, Sink&& sink) {
+  return detail::emit_many<false>(parser, right(sep, parser), sink);
+}
+
+template <Parser P, Parser Sep, typename Sink>
+  requires detail::sink_of<std::decay_t<Sink>, invoke_parser_result_t<P>>
+constexpr auto sepby1_into(P&& parser, Sep&& sep, Sink&& sink) {
+  return detail::annotate<first_v<P>, nullable_v<P>>(detail::emit_many<true>(parser, right(sep, parser), sink));
+}
+
+// matches a parser separated by another parser in a fixed amount of times.
+template <std::size_t N, Parser P, Parser Sep>
+constexpr auto sepby(P&& parser, Sep&& sep) {
+  using V = invoke_parser_result_t<P>;
+  using R = ParserResult<std::array<V, N>>;
+
+  return [parser, sep](const Input& input) {
+    Input rest = input;
+    std::array<V, N> ret;
+    for (std::size_t i = 0; i < N; i++) {
+      if (i != 0) {
+        auto result = sep(rest);
+        if (!result.has_value()) {
+          if (result.error().committed) {
+            return R{ std::unexpect, result.error() };
+          }
+          return R{ std::unexpect, rest, "sepby<> mismatches sep." };
+        }
+        rest = std::get<1>(result.value());
+      }
+
+      auto result = parser(rest);
+      if (!result.has_value()) {
+        if (result.error().committed) {
+          return R{ std::unexpect, result.error() };
+        }
+        return R{ std::unexpect, rest, "sepby<> mismatches parser." };
+      }
+
+      rest = std::get<1>(result.value());
+      ret[i] = std::get<0>(std::move(result).value());
+    }
+
+    return R{ { std::move(ret), rest } };
+  };
+}
+
+// matches the end of the input.
+template <Parser P>
+constexpr auto eof(P&& parser) {
+  using R = ParserResult<invoke_parser_result_t<P>>;
+
+  return detail::annotate<first_v<P>, nullable_v<P>>([parser](const Input& input) {
+    auto result = parser(input);
+    if (result.has_value()) {
+      if (auto rest = std::get<1>(result.value()); !rest.empty()) {
+        return R{ std::unexpect, rest, "not end of input" };
+      }
+    }
+    return result;
+  });
+}
+
 }  // namespace parsec
\ No newline at end of file
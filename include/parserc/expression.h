@@ -0,0 +1,199 @@
+#pragma once
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "combinator.h"
+#include "small_vector.h"
+
+namespace parsec {
+
+namespace detail {
+
+// the stack of the operands of chainr1 and precedence, inline for short
+// expressions if T can be default constructed.
+template <typename T>
+using operand_stack = std::conditional_t<std::default_initializable<T>, small_vector<T, 16>, std::vector<T>>;
+
+// matches an operator followed by an operand. The operator is not consumed if the
+// operand after it fails, like the separator of sepby; a committed failure of the
+// operand fails the whole expression.
+template <Parser Op, Parser P>
+constexpr auto operation(const Op& op, const P& operand, const Input& input) {
+  using R = Result<Output<std::tuple<invoke_parser_result_t<Op>, invoke_parser_result_t<P>>>>;
+
+  auto f = op(input);
+  if (!f.has_value()) {
+    return R{ std::unexpect, f.error() };
+  }
+  auto value = operand(std::get<1>(f.value()));
+  if (!value.has_value()) {
+    return R{ std::unexpect, value.error() };
+  }
+  auto rest = std::get<1>(value.value());
+  return R{ { { std::get<0>(std::move(f).value()), std::get<0>(std::move(value).value()) }, rest } };
+}
+
+}  // namespace detail
+
+// matches operands separated by left associative operators and folds them from the
+// left in one loop: a - b - c is (a - b) - c. The operator returns the function
+// applied to the two operands.
+template <Parser P, Parser Op>
+  requires std::is_invocable_r_v<invoke_parser_result_t<P>, invoke_parser_result_t<Op>,
+                                 invoke_parser_result_t<P>, invoke_parser_result_t<P>>
+constexpr auto chainl1(P&& operand, Op&& op) {
+  using T = invoke_parser_result_t<P>;
+  using R = ParserResult<T>;
+
+  return detail::annotate<first_v<P>, nullable_v<P>>([operand, op](const Input& input) {
+    auto result = operand(input);
+    if (!result.has_value()) {
+      return R{ std::unexpect, result.error() };
+    }
+
+    auto [acc, rest] = std::move(result).value();
+    while (true) {
+      auto next = detail::operation(op, operand, rest);
+      if (!next.has_value()) {
+        if (next.error().committed) {
+          return R{ std::unexpect, next.error() };
+        }
+        break;
+      }
+      auto&& [operation, after] = next.value();
+      auto&& [f, value] = operation;
+      acc = std::invoke(f, std::move(acc), std::move(value));
+      rest = after;
+    }
+    return R{ { std::move(acc), rest } };
+  });
+}
+
+// matches operands separated by right associative operators and folds them from the
+// right without recursion: a ^ b ^ c is a ^ (b ^ c).
+template <Parser P, Parser Op>
+  requires std::is_invocable_r_v<invoke_parser_result_t<P>, invoke_parser_result_t<Op>,
+                                 invoke_parser_result_t<P>, invoke_parser_result_t<P>>
+constexpr auto chainr1(P&& operand, Op&& op) {
+  using T = invoke_parser_result_t<P>;
+  using F = invoke_parser_result_t<Op>;
+  using R = ParserResult<T>;
+
+  return detail::annotate<first_v<P>, nullable_v<P>>([operand, op](const Input& input) {
+    auto result = operand(input);
+    if (!result.has_value()) {
+      return R{ std::unexpect, result.error() };
+    }
+
+    auto [first, rest] = std::move(result).value();
+    detail::operand_stack<T> values;
+    std::vector<F> functions;
+    values.push_back(std::move(first));
+    while (true) {
+      auto next = detail::operation(op, operand, rest);
+      if (!next.has_value()) {
+        if (next.error().committed) {
+          return R{ std::unexpect, next.error() };
+        }
+        break;
+      }
+      auto&& [operation, after] = next.value();
+      functions.push_back(std::move(std::get<0>(operation)));
+      values.push_back(std::move(std::get<1>(operation)));
+      rest = after;
+    }
+
+    T acc = std::move(values.back());
+    for (auto i = functions.size(); i-- > 0;) {
+      acc = std::invoke(functions[i], std::move(values[i]), std::move(acc));
+    }
+    return R{ { std::move(acc), rest } };
+  });
+}
+
+// the associativity of an infix operator.
+enum class assoc { left, right };
+
+// an infix operator of a precedence table: operators of a higher precedence bind
+// tighter, and apply combines the two operands.
+template <typename T>
+struct infix {
+  int precedence;
+  assoc associativity;
+  T (*apply)(T, T);
+};
+
+// matches an expression of operands and the infix operators of a table by
+// precedence climbing, e.g. 1 + 2 * 3 ^ 2 ^ 2 for +, * and a right associative ^.
+// The operator parser returns the index of the operator in the table, like
+// keywords<"+", "*", "^">. Operands and operators are kept on explicit stacks and
+// reduced as soon as an operator of a lower precedence follows, so the expression
+// is parsed in one loop instead of one nested parser per precedence level, and
+// no call recurses however long the expression is. Operands are typically atoms
+// or parenthesized expressions through a rule.
+template <Parser P, Parser Op, typename T, std::size_t N>
+  requires std::same_as<invoke_parser_result_t<P>, T> && std::convertible_to<invoke_parser_result_t<Op>, std::size_t>
+constexpr auto precedence(P&& operand, Op&& op, const std::array<infix<T>, N>& table) {
+  using R = ParserResult<T>;
+
+  return detail::annotate<first_v<P>, nullable_v<P>>([operand, op, table](const Input& input) {
+    auto result = operand(input);
+    if (!result.has_value()) {
+      return R{ std::unexpect, result.error() };
+    }
+
+    auto [first, rest] = std::move(result).value();
+    detail::operand_stack<T> values;
+    small_vector<std::size_t, 16> operators;
+    values.push_back(std::move(first));
+
+    // applies the operator on the top of the stack to the two operands on the top.
+    auto reduce = [&] {
+      auto& top = table[operators.back()];
+      operators.pop_back();
+      T rhs = std::move(values.back());
+      values.pop_back();
+      values.back() = top.apply(std::move(values.back()), std::move(rhs));
+    };
+
+    while (true) {
+      auto next = detail::operation(op, operand, rest);
+      if (!next.has_value()) {
+        if (next.error().committed) {
+          return R{ std::unexpect, next.error() };
+        }
+        break;
+      }
+      auto&& [operation, after] = next.value();
+      std::size_t index = std::get<0>(operation);
+      if (index >= N) {
+        break;
+      }
+
+      // reduces the operators that bind tighter than this one.
+      auto& current = table[index];
+      while (!operators.empty()) {
+        auto& top = table[operators.back()];
+        if (top.precedence < current.precedence ||
+            (top.precedence == current.precedence && current.associativity == assoc::right)) {
+          break;
+        }
+        reduce();
+      }
+      operators.push_back(index);
+      values.push_back(std::move(std::get<1>(operation)));
+      rest = after;
+    }
+
+    while (!operators.empty()) {
+      reduce();
+    }
+    return R{ { std::move(values.back()), rest } };
+  });
+}
+
+}  // namespace parsec
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "trait.h"
+
+namespace parsec {
+
+// a read-only memory mapping of a whole file, viewed as an Input.
+class mapped_file {
+ public:
+  mapped_file() = default;
+
+  mapped_file(mapped_file&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+  mapped_file& operator=(mapped_file&& other) noexcept {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~mapped_file() {
+    unmap();
+  }
+
+  // maps the file, or returns the error of the system.
+  static expected<mapped_file, std::error_code> open(const std::filesystem::path& path) {
+    using R = expected<mapped_file, std::error_code>;
+    mapped_file file;
+#if defined(_WIN32)
+    HANDLE handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+      return R{ std::unexpect, static_cast<int>(GetLastError()), std::system_category() };
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size)) {
+      auto error = static_cast<int>(GetLastError());
+      CloseHandle(handle);
+      return R{ std::unexpect, error, std::system_category() };
+    }
+    file.size_ = static_cast<std::size_t>(size.QuadPart);
+    if (file.size_ != 0) {
+      HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping != nullptr) {
+        file.data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(mapping);
+      }
+      if (file.data_ == nullptr) {
+        auto error = static_cast<int>(GetLastError());
+        CloseHandle(handle);
+        return R{ std::unexpect, error, std::system_category() };
+      }
+    }
+    CloseHandle(handle);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return R{ std::unexpect, errno, std::system_category() };
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+      auto error = errno;
+      close(fd);
+      return R{ std::unexpect, error, std::system_category() };
+    }
+    file.size_ = static_cast<std::size_t>(status.st_size);
+    if (file.size_ != 0) {
+      void* data = mmap(nullptr, file.size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        auto error = errno;
+        close(fd);
+        return R{ std::unexpect, error, std::system_category() };
+      }
+      // records are parsed front to back.
+      madvise(data, file.size_, MADV_SEQUENTIAL);
+      file.data_ = static_cast<const char*>(data);
+    }
+    close(fd);
+#endif
+    return R{ std::move(file) };
+  }
+
+  Input view() const { return { data_, size_ }; }
+
+  std::size_t size() const { return size_; }
+
+ private:
+  void unmap() {
+    if (data_ != nullptr) {
+#if defined(_WIN32)
+      UnmapViewOfFile(data_);
+#else
+      munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  const char* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace parsec
\ No newline at end of file
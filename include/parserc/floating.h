@@ -0,0 +1,303 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+
+#include "trait.h"
+
+namespace parsec {
+
+namespace detail {
+
+// the binary layout of an IEEE-754 float or double.
+template <typename T>
+struct float_info;
+
+template <>
+struct float_info<double> {
+  using bits_type = std::uint64_t;
+  static constexpr int mantissa_bits = 52;
+  static constexpr int exponent_bits = 11;
+  static constexpr int bias = -1023;
+  // the largest exactly representable integer and power of ten.
+  static constexpr std::uint64_t max_exact_mantissa = std::uint64_t{ 1 } << 53;
+  static constexpr int max_exact_exponent = 22;
+};
+
+template <>
+struct float_info<float> {
+  using bits_type = std::uint32_t;
+  static constexpr int mantissa_bits = 23;
+  static constexpr int exponent_bits = 8;
+  static constexpr int bias = -127;
+  static constexpr std::uint64_t max_exact_mantissa = std::uint64_t{ 1 } << 24;
+  static constexpr int max_exact_exponent = 10;
+};
+
+template <typename T>
+constexpr T exact_power_of_ten(int exponent) {
+  constexpr auto powers = [] {
+    std::array<T, 23> powers{};
+    T power = 1;
+    for (auto& p : powers) {
+      p = power;
+      power *= 10;
+    }
+    return powers;
+  }();
+  return powers[exponent];
+}
+
+// the fast path of Clinger: if mantissa and 10^exponent are both exact in T,
+// mantissa * 10^exponent is correctly rounded by one multiplication or division.
+template <typename T>
+constexpr bool fast_float(std::uint64_t mantissa, int exponent, T& value) {
+  using info = float_info<T>;
+  if (mantissa > info::max_exact_mantissa || exponent < -info::max_exact_exponent || exponent > info::max_exact_exponent) {
+    return false;
+  }
+  value = static_cast<T>(mantissa);
+  if (exponent < 0) {
+    value /= exact_power_of_ten<T>(-exponent);
+  } else {
+    value *= exact_power_of_ten<T>(exponent);
+  }
+  return true;
+}
+
+// an arbitrary-precision decimal 0.d[0]d[1]... * 10^dp, the slow path of the
+// correctly rounded conversion in constant evaluation. This is the simple
+// decimal conversion of Go's strconv package.
+class big_decimal {
+ public:
+  static constexpr int capacity = 800;
+
+  // assigns the digits of integer.fraction * 10^exponent.
+  constexpr big_decimal(const Input& integer, const Input& fraction, int exponent) {
+    // the digits dropped past the capacity still count in the decimal point.
+    int digits = 0;
+    for (auto c : integer) {
+      digits += c != '0' || digits > 0;
+      push(c);
+    }
+    dp_ = digits;
+    for (auto c : fraction) {
+      push(c);
+    }
+    dp_ += exponent;
+    trim();
+  }
+
+  // converts to the nearest T, ties to even.
+  template <typename T>
+  constexpr T to_float(bool negative) {
+    using info = float_info<T>;
+    constexpr int powers[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+    constexpr int max_biased = (1 << info::exponent_bits) - 1;
+
+    int exponent = 0;
+    std::uint64_t mantissa = 0;
+    if (nd_ == 0 || dp_ < -330) {
+      exponent = info::bias;
+    } else if (dp_ > 310) {
+      exponent = max_biased + info::bias;
+    } else {
+      // scales by powers of two until in [0.5, 1).
+      while (dp_ > 0) {
+        int n = dp_ >= 9 ? 27 : powers[dp_];
+        shift(-n);
+        exponent += n;
+      }
+      while (dp_ < 0 || (dp_ == 0 && d_[0] < 5)) {
+        int n = -dp_ >= 9 ? 27 : powers[-dp_];
+        shift(n);
+        exponent -= n;
+      }
+
+      // [0.5, 1) to [1, 2), denormals below the smallest exponent.
+      exponent--;
+      if (exponent < info::bias + 1) {
+        int n = info::bias + 1 - exponent;
+        shift(-n);
+        exponent += n;
+      }
+
+      if (exponent - info::bias >= max_biased) {
+        exponent = max_biased + info::bias;
+      } else {
+        shift(1 + info::mantissa_bits);
+        mantissa = rounded_integer();
+
+        // rounding might have added a bit.
+        if (mantissa == std::uint64_t{ 2 } << info::mantissa_bits) {
+          mantissa >>= 1;
+          exponent++;
+        }
+        if (exponent - info::bias >= max_biased) {
+          mantissa = 0;
+          exponent = max_biased + info::bias;
+        } else if ((mantissa & (std::uint64_t{ 1 } << info::mantissa_bits)) == 0) {
+          exponent = info::bias;
+        }
+      }
+    }
+
+    std::uint64_t bits = mantissa & ((std::uint64_t{ 1 } << info::mantissa_bits) - 1);
+    bits |= static_cast<std::uint64_t>((exponent - info::bias) & max_biased) << info::mantissa_bits;
+    if (negative) {
+      bits |= std::uint64_t{ 1 } << (info::mantissa_bits + info::exponent_bits);
+    }
+    return std::bit_cast<T>(static_cast<typename info::bits_type>(bits));
+  }
+
+ private:
+  // the largest shift that keeps 9 * 2^k + carry in 64 bits.
+  static constexpr int max_shift = 60;
+
+  constexpr void push(char c) {
+    if (c == '0' && nd_ == 0) {
+      dp_--;
+    } else if (nd_ < capacity) {
+      d_[nd_++] = static_cast<std::uint8_t>(c - '0');
+    } else if (c != '0') {
+      trunc_ = true;
+    }
+  }
+
+  constexpr void trim() {
+    while (nd_ > 0 && d_[nd_ - 1] == 0) {
+      nd_--;
+    }
+    if (nd_ == 0) {
+      dp_ = 0;
+    }
+  }
+
+  constexpr void shift(int k) {
+    if (nd_ == 0) {
+      return;
+    }
+    for (; k > max_shift; k -= max_shift) {
+      left_shift(max_shift);
+    }
+    for (; k < -max_shift; k += max_shift) {
+      right_shift(max_shift);
+    }
+    if (k > 0) {
+      left_shift(k);
+    } else if (k < 0) {
+      right_shift(-k);
+    }
+  }
+
+  // multiplies by 2^k.
+  constexpr void left_shift(int k) {
+    std::uint64_t carry = 0;
+    for (int i = nd_ - 1; i >= 0; i--) {
+      auto n = (std::uint64_t{ d_[i] } << k) + carry;
+      d_[i] = static_cast<std::uint8_t>(n % 10);
+      carry = n / 10;
+    }
+
+    std::array<std::uint8_t, 20> head{};
+    int h = 0;
+    for (; carry > 0; carry /= 10) {
+      head[h++] = static_cast<std::uint8_t>(carry % 10);
+    }
+    if (nd_ + h > capacity) {
+      for (int i = capacity - h; i < nd_; i++) {
+        trunc_ = trunc_ || d_[i] != 0;
+      }
+      nd_ = capacity - h;
+    }
+    for (int i = nd_ - 1; i >= 0; i--) {
+      d_[i + h] = d_[i];
+    }
+    for (int i = 0; i < h; i++) {
+      d_[i] = head[h - 1 - i];
+    }
+    nd_ += h;
+    dp_ += h;
+    trim();
+  }
+
+  // divides by 2^k.
+  constexpr void right_shift(int k) {
+    int r = 0;
+    int w = 0;
+
+    // picks up enough leading digits to cover the first shift.
+    std::uint64_t n = 0;
+    for (; (n >> k) == 0; r++) {
+      if (r >= nd_) {
+        if (n == 0) {
+          nd_ = 0;
+          return;
+        }
+        for (; (n >> k) == 0; r++) {
+          n *= 10;
+        }
+        break;
+      }
+      n = n * 10 + d_[r];
+    }
+    dp_ -= r - 1;
+
+    const std::uint64_t mask = (std::uint64_t{ 1 } << k) - 1;
+    for (; r < nd_; r++) {
+      auto c = d_[r];
+      d_[w++] = static_cast<std::uint8_t>(n >> k);
+      n = (n & mask) * 10 + c;
+    }
+    for (; n > 0; n = (n & mask) * 10) {
+      auto digit = static_cast<std::uint8_t>(n >> k);
+      if (w < capacity) {
+        d_[w++] = digit;
+      } else if (digit > 0) {
+        trunc_ = true;
+      }
+    }
+    nd_ = w;
+    trim();
+  }
+
+  constexpr bool should_round_up(int nd) const {
+    if (nd < 0 || nd >= nd_) {
+      return false;
+    }
+    // exactly halfway, rounds to even.
+    if (d_[nd] == 5 && nd + 1 == nd_) {
+      return trunc_ || (nd > 0 && d_[nd - 1] % 2 == 1);
+    }
+    return d_[nd] >= 5;
+  }
+
+  constexpr std::uint64_t rounded_integer() const {
+    if (dp_ > 20) {
+      return std::numeric_limits<std::uint64_t>::max();
+    }
+    std::uint64_t n = 0;
+    int i = 0;
+    for (; i < dp_ && i < nd_; i++) {
+      n = n * 10 + d_[i];
+    }
+    for (; i < dp_; i++) {
+      n *= 10;
+    }
+    if (should_round_up(dp_)) {
+      n++;
+    }
+    return n;
+  }
+
+  std::array<std::uint8_t, capacity> d_{};
+  int nd_ = 0;
+  int dp_ = 0;
+  bool trunc_ = false;
+};
+
+}  // namespace detail
+
+}  // namespace parsec
\ No newline at end of file
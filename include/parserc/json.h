@@ -0,0 +1,249 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "character.h"
+#include "combinator.h"
+#include "rule.h"
+#include "token.h"
+
+// a JSON parser (RFC 8259) built from the combinators.
+namespace parsec::json {
+
+// a string as it appears between the quotes, a view of the input. Only a string
+// with escapes needs to be decoded by unescape().
+struct string {
+  std::string_view raw;
+  bool escaped = false;
+
+  friend constexpr bool operator==(const string&, const string&) = default;
+};
+
+struct value;
+
+// arrays and objects are contiguous, the members of an object in their order.
+using array = std::vector<value>;
+using member = std::pair<string, value>;
+using object = std::vector<member>;
+
+struct value {
+  std::variant<std::nullptr_t, bool, double, string, array, object> data;
+
+  template <typename T>
+  constexpr bool is() const {
+    return std::holds_alternative<T>(data);
+  }
+
+  template <typename T>
+  constexpr const T& as() const {
+    return std::get<T>(data);
+  }
+
+  // the value of the first member named key, or nullptr.
+  const value* find(std::string_view key) const;
+
+  friend bool operator==(const value&, const value&) = default;
+};
+
+// decodes the escapes of a string into UTF-8. Unpaired surrogates become U+FFFD.
+inline std::string unescape(const string& s) {
+  if (!s.escaped) {
+    return std::string(s.raw);
+  }
+
+  auto hex4 = [](std::string_view digits) {
+    std::uint32_t ret = 0;
+    for (auto c : digits) {
+      ret = ret * 16 + static_cast<std::uint32_t>(parsec::detail::digit_value(c));
+    }
+    return ret;
+  };
+  auto utf8 = [](std::string& out, std::uint32_t cp) {
+    if (cp < 0x80) {
+      out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+      out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+      out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+      out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+      out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+      out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+      out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+  };
+
+  std::string ret;
+  ret.reserve(s.raw.size());
+  auto raw = s.raw;
+  for (std::size_t i = 0; i < raw.size(); i++) {
+    if (raw[i] != '\\') {
+      ret.push_back(raw[i]);
+      continue;
+    }
+    switch (raw[++i]) {
+      case 'b': ret.push_back('\b'); break;
+      case 'f': ret.push_back('\f'); break;
+      case 'n': ret.push_back('\n'); break;
+      case 'r': ret.push_back('\r'); break;
+      case 't': ret.push_back('\t'); break;
+      case 'u': {
+        auto cp = hex4(raw.substr(i + 1, 4));
+        i += 4;
+        if (cp >= 0xD800 && cp < 0xDC00 && raw.substr(i + 1, 2) == "\\u") {
+          auto low = hex4(raw.substr(i + 3, 4));
+          if (low >= 0xDC00 && low < 0xE000) {
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            i += 6;
+          }
+        }
+        utf8(ret, cp >= 0xD800 && cp < 0xE000 ? 0xFFFD : cp);
+        break;
+      }
+      default: ret.push_back(raw[i]); break;
+    }
+  }
+  return ret;
+}
+
+inline const value* value::find(std::string_view key) const {
+  if (!is<object>()) {
+    return nullptr;
+  }
+  for (auto& [name, v] : as<object>()) {
+    if (name.escaped ? unescape(name) == key : name.raw == key) {
+      return &v;
+    }
+  }
+  return nullptr;
+}
+
+// whitespace between the tokens.
+inline constexpr auto ws = take_while(one_of<' ', '\t', '\n', '\r'>);
+
+// matches a string and returns it without decoding, see unescape().
+inline constexpr auto string_parser = parsec::detail::annotate<charmap::of('"'), false>([](const Input& input) {
+  using R = ParserResult<string>;
+  constexpr auto plain = take_while(charset<~(charmap::of('"', '\\') | charmap::range('\0', '\x1f'))>{});
+
+  if (input.empty() || input[0] != '"') {
+    return R{ std::unexpect, input, "json string dismatches." };
+  }
+  Input rest = input.substr(1);
+  bool escaped = false;
+  while (true) {
+    rest = std::get<1>(plain(rest).value());
+    if (rest.empty()) {
+      return R{ std::unexpect, rest, "json string is not closed." };
+    }
+    if (rest[0] == '"') {
+      break;
+    }
+    if (rest[0] != '\\') {
+      return R{ std::unexpect, rest, "json string has a control character." };
+    }
+
+    escaped = true;
+    if (rest.size() >= 2 && Input("\"\\/bfnrt").find(rest[1]) != Input::npos) {
+      rest.remove_prefix(2);
+    } else if (rest.size() >= 6 && rest[1] == 'u' &&
+               std::get<0>(take_while(hexdigit)(rest.substr(2, 4)).value()).size() == 4) {
+      rest.remove_prefix(6);
+    } else {
+      return R{ std::unexpect, rest, "json escape dismatches." };
+    }
+  }
+  auto raw = input.substr(1, input.size() - rest.size() - 1);
+  return R{ { string{ raw, escaped }, rest.substr(1) } };
+});
+
+// matches a number: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?, correctly rounded.
+inline constexpr auto number_parser = parsec::detail::annotate<digit.map | charmap::of('-'), false>([](const Input& input) {
+  using R = ParserResult<double>;
+  auto digits = [&](std::size_t i) {
+    return std::get<0>(take_while(digit)(input.substr(i)).value()).size();
+  };
+
+  std::size_t n = input.starts_with('-');
+  auto integer = digits(n);
+  if (integer == 0 || (integer > 1 && input[n] == '0')) {
+    return R{ std::unexpect, input, "json number dismatches." };
+  }
+  n += integer;
+  if (n < input.size() && input[n] == '.') {
+    auto fraction = digits(n + 1);
+    if (fraction == 0) {
+      return R{ std::unexpect, input.substr(n), "json number dismatches fraction." };
+    }
+    n += 1 + fraction;
+  }
+  if (n < input.size() && (input[n] == 'e' || input[n] == 'E')) {
+    auto sign = n + 1 < input.size() && (input[n + 1] == '+' || input[n + 1] == '-');
+    auto exponent = digits(n + 1 + sign);
+    if (exponent == 0) {
+      return R{ std::unexpect, input.substr(n), "json number dismatches exponent." };
+    }
+    n += 1 + sign + exponent;
+  }
+
+  auto result = floating<double>(input.substr(0, n));
+  return R{ { std::get<0>(result.value()), input.substr(n) } };
+});
+
+// the value parser, a rule whose nesting is limited to rule<value>::default_max_depth.
+inline const rule<value>& value_parser() {
+  static rule<value> parse;
+
+  // keeps the first set of a parser through map, so that the choice of a value
+  // only tries the alternative that its first character starts.
+  constexpr auto to_value = [](auto parser) {
+    using P = decltype(parser);
+    return parsec::detail::annotate<first_v<P>, nullable_v<P>>(parser | map([](auto v) { return value{ std::move(v) }; }));
+  };
+
+  // '[', '{' and ',' commit to what follows, so a failure inside an element is
+  // reported where it happens instead of at the enclosing ']' or '}'.
+  static const auto element = commit(left(parse, ws));
+  static const auto comma = left(one_of<','>, ws);
+  static const auto array_parser = to_value(
+      right(left(one_of<'['>, ws), commit((one_of<']'> | map([](char) { return array{}; })) ||
+                                          left(sepby1(element, comma), one_of<']'>))));
+
+  static const auto member_parser =
+      commit(left(string_parser + right(between(ws, one_of<':'>, ws), left(parse, ws)), ws)) |
+      map([](std::tuple<string, value> m) { return member{ std::get<0>(m), std::move(std::get<1>(m)) }; });
+  static const auto object_parser = to_value(
+      right(left(one_of<'{'>, ws), commit((one_of<'}'> | map([](char) { return object{}; })) ||
+                                          left(sepby1(member_parser, comma), one_of<'}'>))));
+
+  using literals = decltype(keywords<"null", "true", "false">);
+  static const auto literal = parsec::detail::annotate<first_v<literals>, false>(
+      keywords<"null", "true", "false"> | map([](std::size_t index) {
+        return index == 0 ? value{ nullptr } : value{ index == 1 };
+      }));
+
+  static const auto definition =
+      object_parser || array_parser || to_value(string_parser) || to_value(number_parser) || literal;
+  static const bool defined = (parse = definition, true);
+  (void)defined;
+  return parse;
+}
+
+// parses a JSON text, a value with optional whitespace around it.
+inline Result<value> parse(const Input& input) {
+  static const auto text = eof(right(ws, left(value_parser(), ws)));
+  auto result = text(input);
+  if (!result.has_value()) {
+    return Result<value>{ std::unexpect, result.error() };
+  }
+  return Result<value>{ std::get<0>(std::move(result).value()) };
+}
+
+}  // namespace parsec::json
\ No newline at end of file
@@ -0,0 +1,201 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "combinator.h"
+
+namespace parsec {
+
+class memo_table;
+
+namespace detail {
+
+// the memo table that memo() parsers of this thread use, if any.
+inline thread_local memo_table* current_memo = nullptr;
+
+// dense ids for the rules and the result types of memo tables.
+inline std::atomic<std::uint32_t> next_type_id = 0;
+
+template <typename T>
+std::uint32_t type_id() {
+  static const std::uint32_t id = next_type_id++;
+  return id;
+}
+
+}  // namespace detail
+
+// the results of memo() parsers during a parse, keyed on (rule, offset into the input).
+// While a table is alive it is used by the memo() parsers of its thread. Tables nest,
+// the innermost one is used. Left recursive rules are not supported.
+class memo_table {
+ public:
+  // memoizes the parsers over the input and its suffixes.
+  explicit memo_table(const Input& input) : input_(input), previous_(detail::current_memo) {
+    detail::current_memo = this;
+  }
+
+  memo_table(const memo_table&) = delete;
+  memo_table& operator=(const memo_table&) = delete;
+
+  ~memo_table() {
+    detail::current_memo = previous_;
+  }
+
+  // forgets every result and memoizes over a new input, keeping the memory.
+  void reset(const Input& input) {
+    input_ = input;
+    size_ = 0;
+    if (++generation_ == 0) {
+      std::fill(entries_.begin(), entries_.end(), entry{});
+      generation_ = 1;
+    }
+    for (auto& values : values_) {
+      if (values) {
+        values->clear();
+      }
+    }
+  }
+
+  // the number of memoized results.
+  std::size_t size() const { return size_; }
+
+  // returns the memoized result of rule at the input or stores the one of parse().
+  template <typename F>
+  auto get(std::uint32_t rule, const Input& input, const F& parse) {
+    using R = decltype(parse());
+
+    // only suffixes of the input have an offset.
+    auto end = input_.data() + input_.size();
+    if (input.data() < input_.data() || input.data() > end || input.data() + input.size() != end) {
+      return parse();
+    }
+    auto offset = static_cast<std::uint64_t>(input.data() - input_.data());
+
+    auto& list = values<R>();
+    if (auto* e = find(rule, offset)) {
+      return list[e->slot];
+    }
+
+    // the parse may insert other results and move the entries.
+    auto result = parse();
+    if (size_ + 1 > entries_.size() / 2) {
+      grow();
+    }
+    auto& e = *slot_of(rule, offset);
+    e = { rule, static_cast<std::uint32_t>(list.size()), offset, generation_ };
+    list.push_back(result);
+    size_++;
+    return result;
+  }
+
+ private:
+  struct entry {
+    std::uint32_t rule = 0;
+    std::uint32_t slot = 0;
+    std::uint64_t offset = 0;
+    // the entry is empty unless it is of the current generation.
+    std::uint32_t generation = 0;
+  };
+
+  struct values_base {
+    virtual ~values_base() = default;
+    virtual void clear() = 0;
+  };
+
+  template <typename R>
+  struct values_of : values_base {
+    std::vector<R> list;
+    void clear() override { list.clear(); }
+  };
+
+  template <typename R>
+  std::vector<R>& values() {
+    auto id = detail::type_id<R>();
+    if (id >= values_.size()) {
+      values_.resize(id + 1);
+    }
+    if (!values_[id]) {
+      values_[id] = std::make_unique<values_of<R>>();
+    }
+    return static_cast<values_of<R>*>(values_[id].get())->list;
+  }
+
+  std::size_t hash(std::uint32_t rule, std::uint64_t offset) const {
+    auto key = ((offset << 20) ^ rule) * 0x9E3779B97F4A7C15;
+    return static_cast<std::size_t>(key >> 32) & (entries_.size() - 1);
+  }
+
+  // the entry of (rule, offset) or the empty entry where it belongs, open addressing.
+  entry* slot_of(std::uint32_t rule, std::uint64_t offset) {
+    for (auto i = hash(rule, offset);; i = (i + 1) & (entries_.size() - 1)) {
+      auto& e = entries_[i];
+      if (e.generation != generation_ || (e.rule == rule && e.offset == offset)) {
+        return &e;
+      }
+    }
+  }
+
+  entry* find(std::uint32_t rule, std::uint64_t offset) {
+    if (entries_.empty()) {
+      return nullptr;
+    }
+    auto* e = slot_of(rule, offset);
+    return e->generation == generation_ ? e : nullptr;
+  }
+
+  void grow() {
+    auto old = std::move(entries_);
+    entries_.assign(std::max<std::size_t>(64, old.size() * 2), entry{});
+    for (auto& e : old) {
+      if (e.generation == generation_) {
+        *slot_of(e.rule, e.offset) = e;
+      }
+    }
+  }
+
+  Input input_;
+  memo_table* previous_;
+  std::vector<entry> entries_;
+  std::vector<std::unique_ptr<values_base>> values_;
+  std::uint32_t generation_ = 1;
+  std::size_t size_ = 0;
+};
+
+namespace detail {
+
+template <typename P, typename Rule>
+struct memo_parser {
+  static constexpr charmap first = first_v<P>;
+  static constexpr bool nullable = nullable_v<P>;
+
+  P parser;
+
+  constexpr auto operator()(const Input& input) const {
+    if !consteval {
+      if (current_memo != nullptr) {
+        return current_memo->get(type_id<Rule>(), input, [&]() {
+          return parser(input);
+        });
+      }
+    }
+    return parser(input);
+  }
+};
+
+}  // namespace detail
+
+// memoizes the results of a parser in the current memo_table, so backtracking
+// re-parses it at most once at each offset. Without a table it is the parser itself.
+// Each memo() in the source is one rule, and its copies share the results. A memo()
+// in a function that builds several parsers needs a distinct Rule for each of them,
+// e.g. memo<struct term>(parser).
+template <typename Rule = decltype([] {}), Parser P>
+constexpr auto memo(P&& parser) {
+  return detail::memo_parser<std::decay_t<P>, Rule>{ std::forward<P>(parser) };
+}
+
+}  // namespace parsec
\ No newline at end of file
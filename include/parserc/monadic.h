@@ -1,63 +1,60 @@
-#include "trait.h"
-
-namespace parsec {
-
-// pipe operator
-template <Parser P, typename F>
-constexpr auto operator|(P&& parser, F&& f) {
-  return [parser, f](const Input& input) {
-    return f(parser(input));
-  };
-}
-
-// converts the parser's result to anther type
-template <typename F>
-constexpr auto to(F&& f) {
-  return [f](auto&& result) {
-    return result.and_then([f](auto&& result) {
-      auto&& [value, rest] = result;
-
-      using V = decltype(value);
-      using R = std::invoke_result_t<F, V>;
-      static_assert(not std::is_same_v<R, void>,
-          "map requires the return type of F not to be void.");
-
-      return Result<R>{ f(value) };
-    });
-  };
-}
-
-// map a function over the result of a parser
-template <typename F>
-constexpr auto map(F&& f) {
-  return [f](auto&& result) {
-    return result.map([f](auto&& result) {
-      auto&& [value, rest] = result;
-
-      using V = decltype(value);
-      using R = std::invoke_result_t<F, V>;
-      static_assert(not std::is_same_v<R, void>,
-          "map requires the return type of F not to be void.");
-
-      return Output<R>{ f(value), rest };
-    });
-  };
-}
-
-// applies a function over the input if the parser failed
-template <std::invocable<> F>
-constexpr auto or_else(F&& f) {
-  return [f](auto&& result) {
-    return result.or_else(f);
-  };
-}
-
-// applies a function over the result of a parser
-template <typename F>
-constexpr auto and_then(F&& f) {
-  return [f](auto&& result) {
-    return result.and_then(f);
-  };
-}
-
+#include "trait.h"
+
+namespace parsec {
+
+// pipe operator
+template <Parser P, typename F>
+constexpr auto operator|(P&& parser, F&& f) {
+  return [parser = std::forward<P>(parser), f = std::forward<F>(f)](const Input& input) {
+    return f(parser(input));
+  };
+}
+
+// converts the parser's result to anther type
+template <typename F>
+constexpr auto to(F&& f) {
+  return [f = std::forward<F>(f)](auto&& result) {
+    return std::forward<decltype(result)>(result).and_then([&f](auto&& result) {
+      using V = std::tuple_element_t<0, std::remove_cvref_t<decltype(result)>>;
+      using R = std::invoke_result_t<F, V>;
+      static_assert(not std::is_same_v<R, void>,
+          "map requires the return type of F not to be void.");
+
+      return Result<R>{ f(std::get<0>(std::forward<decltype(result)>(result))) };
+    });
+  };
+}
+
+// map a function over the result of a parser
+template <typename F>
+constexpr auto map(F&& f) {
+  return [f = std::forward<F>(f)](auto&& result) {
+    return std::forward<decltype(result)>(result).map([&f](auto&& result) {
+      using V = std::tuple_element_t<0, std::remove_cvref_t<decltype(result)>>;
+      using R = std::invoke_result_t<F, V>;
+      static_assert(not std::is_same_v<R, void>,
+          "map requires the return type of F not to be void.");
+
+      auto rest = std::get<1>(result);
+      return Output<R>{ f(std::get<0>(std::forward<decltype(result)>(result))), rest };
+    });
+  };
+}
+
+// applies a function over the input if the parser failed
+template <std::invocable<> F>
+constexpr auto or_else(F&& f) {
+  return [f = std::forward<F>(f)](auto&& result) {
+    return std::forward<decltype(result)>(result).or_else(f);
+  };
+}
+
+// applies a function over the result of a parser
+template <typename F>
+constexpr auto and_then(F&& f) {
+  return [f = std::forward<F>(f)](auto&& result) {
+    return std::forward<decltype(result)>(result).and_then(f);
+  };
+}
+
 }  // namespace parsec
\ No newline at end of file
@@ -0,0 +1,321 @@
+#pragma once
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#include "character.h"
+#include "combinator.h"
+#include "profile.h"
+#include "token.h"
+
+namespace parsec {
+
+namespace detail {
+
+// the character of a set of one character, or -1.
+constexpr int single_char(const charmap& map) {
+  int ret = -1;
+  for (int c = 0; c < 256; c++) {
+    if (map.contains(static_cast<char>(c))) {
+      if (ret >= 0) {
+        return -1;
+      }
+      ret = c;
+    }
+  }
+  return ret;
+}
+
+// the text of a parser that always matches the same string: a literal or a set
+// of one character.
+template <typename P>
+struct fixed_text : std::false_type {};
+
+template <fixed_string S>
+struct fixed_text<literal<S>> : std::true_type {
+  static constexpr auto text = S;
+};
+
+template <charmap M>
+  requires(single_char(M) >= 0)
+struct fixed_text<charset<M>> : std::true_type {
+  static constexpr auto text = [] {
+    fixed_string<2> ret;
+    ret.data[0] = static_cast<char>(single_char(M));
+    return ret;
+  }();
+};
+
+template <typename P>
+struct skipped_text : std::false_type {};
+
+template <typename P>
+  requires fixed_text<P>::value
+struct skipped_text<skipped<P>> : std::true_type {
+  static constexpr auto text = fixed_text<P>::text;
+};
+
+template <fixed_string A, fixed_string B>
+constexpr auto concat() {
+  fixed_string<A.size() + B.size() + 1> ret;
+  for (std::size_t i = 0; i < A.size(); i++) {
+    ret.data[i] = A.data[i];
+  }
+  for (std::size_t i = 0; i < B.size(); i++) {
+    ret.data[A.size() + i] = B.data[i];
+  }
+  return ret;
+}
+
+template <fixed_string S, std::size_t Begin, std::size_t End>
+constexpr auto substr() {
+  fixed_string<End - Begin + 1> ret;
+  for (std::size_t i = Begin; i < End; i++) {
+    ret.data[i - Begin] = S.data[i];
+  }
+  return ret;
+}
+
+// the length of the common prefix of two strings.
+constexpr std::size_t common_prefix(std::string_view a, std::string_view b) {
+  std::size_t n = 0;
+  while (n < a.size() && n < b.size() && a[n] == b[n]) {
+    n++;
+  }
+  return n;
+}
+
+template <typename... Ps>
+constexpr auto drop_first(const std::tuple<Ps...>& parsers) {
+  return std::apply([](const auto&, const auto&... rest) {
+    return std::tuple<std::decay_t<decltype(rest)>...>{ rest... };
+  }, parsers);
+}
+
+template <typename Tuple>
+using first_element_t = std::remove_cvref_t<std::tuple_element_t<0, Tuple>>;
+
+// merges skipped fixed texts next to each other in a sequence into one literal.
+template <typename... Ps>
+constexpr auto merge_texts(const std::tuple<Ps...>& parsers) {
+  if constexpr (sizeof...(Ps) < 2) {
+    return parsers;
+  } else {
+    auto rest = merge_texts(drop_first(parsers));
+    using H = first_element_t<std::tuple<Ps...>>;
+    using N = first_element_t<decltype(rest)>;
+    if constexpr (skipped_text<H>::value && skipped_text<N>::value) {
+      constexpr auto text = concat<skipped_text<H>::text, skipped_text<N>::text>();
+      return std::tuple_cat(std::tuple{ skip(literal<text>{}) }, drop_first(rest));
+    } else {
+      return std::tuple_cat(std::tuple<H>{ std::get<0>(parsers) }, rest);
+    }
+  }
+}
+
+template <typename P>
+struct is_charset : std::false_type {};
+
+template <charmap M>
+struct is_charset<charset<M>> : std::true_type {};
+
+// merges sets of characters next to each other in a choice into one set.
+template <typename... Ps>
+constexpr auto merge_charsets(const std::tuple<Ps...>& parsers) {
+  if constexpr (sizeof...(Ps) < 2) {
+    return parsers;
+  } else {
+    auto rest = merge_charsets(drop_first(parsers));
+    using H = first_element_t<std::tuple<Ps...>>;
+    using N = first_element_t<decltype(rest)>;
+    if constexpr (is_charset<H>::value && is_charset<N>::value) {
+      return std::tuple_cat(std::tuple{ charset<H::map | N::map>{} }, drop_first(rest));
+    } else {
+      return std::tuple_cat(std::tuple<H>{ std::get<0>(parsers) }, rest);
+    }
+  }
+}
+
+// a parser without state, all of whose values match the same.
+template <typename P>
+inline constexpr bool stateless_v = std::is_empty_v<P>;
+
+template <typename P>
+inline constexpr bool stateless_v<skipped<P>> = stateless_v<P>;
+
+template <typename P>
+constexpr auto rewrite(const P& parser);
+
+// the parsers of a sequence after its first one, as one parser.
+template <typename... Ps>
+constexpr auto tail(const seq_parser<Ps...>& parser) {
+  if constexpr (sizeof...(Ps) == 2) {
+    return std::get<1>(parser.parsers);
+  } else {
+    return make_seq(drop_first(parser.parsers));
+  }
+}
+
+// a sequence whose first parser is a skipped literal split after n characters.
+template <std::size_t N, typename... Ps>
+constexpr auto split_head(const seq_parser<Ps...>& parser) {
+  constexpr auto text = skipped_text<first_element_t<std::tuple<Ps...>>>::text;
+  constexpr auto head = substr<text, 0, N>();
+  constexpr auto rest = substr<text, N, text.size()>();
+  return make_seq(std::tuple_cat(std::tuple{ skip(literal<head>{}), skip(literal<rest>{}) }, drop_first(parser.parsers)));
+}
+
+// factors the common first parser out of two sequences, a b | a c to a (b | c),
+// or returns nothing if their values would change. The first parser must be
+// stateless, so that both are the same parser and match the same.
+template <typename A, typename B>
+constexpr auto factor(const A& a, const B& b) {
+  if constexpr (is_seq_parser<A>::value && is_seq_parser<B>::value) {
+    using HA = first_element_t<decltype(a.parsers)>;
+    using HB = first_element_t<decltype(b.parsers)>;
+    if constexpr (!std::same_as<HA, HB> && skipped_text<HA>::value && skipped_text<HB>::value) {
+      // literals with a common prefix are split after it first.
+      constexpr auto n = common_prefix(skipped_text<HA>::text, skipped_text<HB>::text);
+      if constexpr (n == 0) {
+        return std::tuple<>{};
+      } else if constexpr (n == skipped_text<HA>::text.size()) {
+        return factor(a, split_head<n>(b));
+      } else if constexpr (n == skipped_text<HB>::text.size()) {
+        return factor(split_head<n>(a), b);
+      } else {
+        return factor(split_head<n>(a), split_head<n>(b));
+      }
+    } else if constexpr (std::same_as<HA, HB> && stateless_v<HA>) {
+      using TA = decltype(tail(a));
+      using TB = decltype(tail(b));
+      if constexpr (is_skipped<TA>::value && is_skipped<TB>::value) {
+        // the values of both are discarded, they need not be the same.
+        using VA = invoke_parser_result_t<decltype(tail(a).parser)>;
+        using VB = invoke_parser_result_t<decltype(tail(b).parser)>;
+        if constexpr (std::same_as<VA, VB>) {
+          auto ret = seq(HA{}, skip(rewrite(choice(tail(a).parser, tail(b).parser))));
+          if constexpr (std::same_as<typename decltype(ret)::value_type, typename A::value_type>) {
+            return std::tuple{ ret };
+          } else {
+            return std::tuple<>{};
+          }
+        } else {
+          return std::tuple<>{};
+        }
+      } else if constexpr (std::same_as<invoke_parser_result_t<TA>, invoke_parser_result_t<TB>>) {
+        // the values of sequences are kept one by one, so that they stay flat.
+        auto ret = [&] {
+          if constexpr (is_seq_parser<TA>::value && std::tuple_size_v<typename TA::values_type> != 1) {
+            using C = decltype(rewrite(choice(tail(a), tail(b))));
+            return seq(HA{}, spliced<C>{ rewrite(choice(tail(a), tail(b))) });
+          } else {
+            return seq(HA{}, rewrite(choice(tail(a), tail(b))));
+          }
+        }();
+        if constexpr (std::same_as<typename decltype(ret)::value_type, typename A::value_type>) {
+          return std::tuple{ ret };
+        } else {
+          return std::tuple<>{};
+        }
+      } else {
+        return std::tuple<>{};
+      }
+    } else {
+      return std::tuple<>{};
+    }
+  } else {
+    return std::tuple<>{};
+  }
+}
+
+// factors the common prefixes of the alternatives next to each other in a choice.
+template <typename... Ps>
+constexpr auto factor_alternatives(const std::tuple<Ps...>& parsers) {
+  if constexpr (sizeof...(Ps) < 2) {
+    return parsers;
+  } else {
+    auto rest = factor_alternatives(drop_first(parsers));
+    auto factored = factor(std::get<0>(parsers), std::get<0>(rest));
+    if constexpr (std::tuple_size_v<decltype(factored)> == 1) {
+      return std::tuple_cat(factored, drop_first(rest));
+    } else {
+      return std::tuple_cat(std::tuple{ std::get<0>(parsers) }, rest);
+    }
+  }
+}
+
+// a parser of a sequence whose value is discarded: a list is not collected.
+template <typename P>
+constexpr auto discard(const P& parser) {
+  if constexpr (is_skipped<P>::value && requires { typename decltype(parser.parser)::list_type; }) {
+    return skip(skip_many(parser.parser.parser));
+  } else {
+    return parser;
+  }
+}
+
+template <typename... Ps>
+constexpr auto rewrite_seq(const seq_parser<Ps...>& parser) {
+  auto parsers = std::apply([](const auto&... parsers) {
+    return std::tuple_cat(elements(discard(rewrite(parsers)))...);
+  }, parser.parsers);
+  return make_seq(merge_texts(parsers));
+}
+
+template <typename... Ps>
+constexpr auto rewrite_choice(const choice_parser<Ps...>& parser) {
+  auto parsers = std::apply([](const auto&... parsers) {
+    return std::tuple_cat(alternatives(rewrite(parsers))...);
+  }, parser.parsers);
+  auto merged = factor_alternatives(merge_charsets(parsers));
+  if constexpr (std::tuple_size_v<decltype(merged)> == 1) {
+    return std::get<0>(merged);
+  } else if constexpr (std::tuple_size_v<decltype(merged)> <= max_alternatives) {
+    return make_choice(merged);
+  } else {
+    return parser;
+  }
+}
+
+// rewrites a parser into an equivalent one, see optimize.
+template <typename P>
+constexpr auto rewrite(const P& parser) {
+  if constexpr (is_seq_parser<P>::value) {
+    return rewrite_seq(parser);
+  } else if constexpr (is_choice_parser<P>::value) {
+    return rewrite_choice(parser);
+  } else if constexpr (is_skipped<P>::value) {
+    return skip(rewrite(parser.parser));
+  } else if constexpr (is_named_parser<P>::value) {
+    // the rewritten parsers are not the rules that were named.
+    return rewrite(parser.parser);
+  } else if constexpr (requires { typename P::list_type; }) {
+    auto inner = rewrite(parser.parser);
+    return many_parser<typename P::list_type, decltype(inner)>{ inner };
+  } else {
+    return parser;
+  }
+}
+
+}  // namespace detail
+
+// rewrites a grammar built from seq, choice, skip, many, sets of characters and
+// literals into an equivalent one that parses faster, at compile time:
+// * skipped literals and characters next to each other in a sequence are merged
+//   into one literal, e.g. skip(one_of<'<'>) + skip(one_of<'='>) to skip(lit<"<=">).
+// * sets of characters next to each other in a choice are merged into one set.
+// * a common first parser of alternatives next to each other is factored out,
+//   a b || a c to a (b || c), if it is stateless and the value does not change.
+//   Skipped literals with a common prefix are split after it first, so
+//   skip(lit<"Content-Length">) || skip(lit<"Content-Type">) tries "Content-" once.
+// * a skipped many is a skip_many, which does not collect a list, and scans the
+//   input if it repeats a set of characters.
+// * named() parsers are replaced by the parsers they name.
+// Other parsers, e.g. the ones built by map(), are kept as they are. A failure
+// inside a merged literal is reported at its start.
+template <Parser P>
+constexpr auto optimize(P&& parser) {
+  return detail::rewrite(std::decay_t<P>(std::forward<P>(parser)));
+}
+
+}  // namespace parsec
\ No newline at end of file
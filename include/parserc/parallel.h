@@ -0,0 +1,189 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "thread_pool.h"
+#include "trait.h"
+
+namespace parsec {
+
+namespace detail {
+
+// the start of the first record at or after `at`: just past the next delimiter.
+constexpr std::size_t next_record(const Input& input, std::size_t at, char delimiter) {
+  auto i = input.find(delimiter, at);
+  return i == Input::npos ? input.size() : i + 1;
+}
+
+// the start of the first record at or after `at`: where the resync parser matches.
+template <Parser Resync>
+constexpr std::size_t next_record(const Input& input, std::size_t at, const Resync& resync) {
+  for (; at < input.size(); at++) {
+    if (resync(input.substr(at)).has_value()) {
+      return at;
+    }
+  }
+  return input.size();
+}
+
+// the inputs smaller than this are not split any further.
+inline constexpr std::size_t min_chunk_size = 1 << 16;
+
+// the items of a batch a thread parses at least, a multiple of 64 so that no word
+// of the success bitmap, nor its cache line, is shared by two threads.
+inline constexpr std::size_t min_batch_size = 512;
+
+// the value a batch stores: the value of a parser, or the whole value of a
+// parser converted with to(), e.g. an address.
+template <typename T>
+struct batch_value {
+  using type = T;
+  static constexpr T&& get(T&& value) { return std::move(value); }
+};
+
+template <typename T>
+struct batch_value<Output<T>> {
+  using type = T;
+  static constexpr T&& get(Output<T>&& value) { return std::get<0>(std::move(value)); }
+};
+
+template <Parser P>
+using batch_value_t = batch_value<invoke_parser_output_t<P>>::type;
+
+// parses inputs[begin, end) into outputs and the success bitmap, begin a multiple of 64.
+template <Parser P>
+constexpr std::size_t parse_batch(const P& parser, std::span<const Input> inputs,
+                                  std::span<batch_value_t<P>> outputs, std::span<std::uint64_t> parsed,
+                                  std::size_t begin, std::size_t end) {
+  std::size_t successes = 0;
+  for (std::size_t word = begin; word < end; word += 64) {
+    std::uint64_t bits = 0;
+    for (std::size_t i = word; i < std::min(word + 64, end); i++) {
+      auto result = parser(inputs[i]);
+      if (result.has_value()) {
+        outputs[i] = batch_value<invoke_parser_output_t<P>>::get(std::move(result).value());
+        bits |= std::uint64_t{ 1 } << (i - word);
+      }
+    }
+    parsed[word / 64] = bits;
+    successes += std::popcount(bits);
+  }
+  return successes;
+}
+
+}  // namespace detail
+
+// parses an input made of records, e.g. a memory-mapped file, on a thread pool.
+// The input is split into chunks at record boundaries, each one the first position
+// after a delimiter or where a resync parser matches, and each chunk is parsed
+// record by record. Return the values of the records in order, or the error of the
+// first record that fails, with its position in the whole input.
+template <Parser P, typename Boundary>
+  requires std::same_as<Boundary, char> || Parser<Boundary>
+Result<std::vector<invoke_parser_result_t<P>>> parse_parallel(
+    const P& parser, const Input& input, const Boundary& boundary, thread_pool& pool) {
+  using V = invoke_parser_result_t<P>;
+  using R = Result<std::vector<V>>;
+
+  // a few chunks per thread, so that threads with fast chunks steal the rest.
+  std::size_t chunks = std::max<std::size_t>(1, std::min(pool.size() * 8, input.size() / detail::min_chunk_size));
+  std::vector<std::size_t> begins(chunks + 1, input.size());
+  begins[0] = 0;
+  for (std::size_t i = 1; i < chunks; i++) {
+    auto at = std::max(begins[i - 1], input.size() * i / chunks);
+    begins[i] = at == 0 ? 0 : detail::next_record(input, at, boundary);
+  }
+
+  std::vector<std::vector<V>> values(chunks);
+  std::vector<std::optional<Error>> errors(chunks);
+  pool.for_each(chunks, [&](std::size_t i) {
+    Input rest = input.substr(begins[i], begins[i + 1] - begins[i]);
+    while (!rest.empty()) {
+      auto result = parser(rest);
+      if (!result.has_value()) {
+        // the error as a suffix of the whole input.
+        auto offset = begins[i + 1] - result.error().remaining;
+        errors[i] = Error{ input.substr(offset), result.error().expected };
+        return;
+      }
+      auto next = std::get<1>(result.value());
+      if (next.size() == rest.size()) {
+        errors[i] = Error{ input.substr(begins[i + 1] - rest.size()), "record is empty." };
+        return;
+      }
+      values[i].emplace_back(std::get<0>(std::move(result).value()));
+      rest = next;
+    }
+  });
+
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < chunks; i++) {
+    if (errors[i].has_value()) {
+      return R{ std::unexpect, *errors[i] };
+    }
+    size += values[i].size();
+  }
+
+  std::vector<V> ret;
+  ret.reserve(size);
+  for (auto& list : values) {
+    std::move(list.begin(), list.end(), std::back_inserter(ret));
+  }
+  return R{ std::move(ret) };
+}
+
+// the words of the success bitmap of a batch of n inputs.
+constexpr std::size_t batch_words(std::size_t n) {
+  return (n + 63) / 64;
+}
+
+// parses many small independent inputs, e.g. one address per input. The value of
+// inputs[i] is written to outputs[i] and bit i % 64 of parsed[i / 64] is set when it
+// parses, and cleared otherwise, leaving outputs[i] as it was. The parser decides
+// whether the whole input must match, e.g. with eof. outputs must have room for
+// every input and parsed for batch_words(inputs.size()) words. Return the number of
+// inputs that parse.
+template <Parser P>
+constexpr std::size_t parse_batch(const P& parser, std::span<const Input> inputs,
+                                  std::span<detail::batch_value_t<P>> outputs, std::span<std::uint64_t> parsed) {
+  return detail::parse_batch(parser, inputs, outputs, parsed, 0, inputs.size());
+}
+
+// parse_batch sharded across a thread pool.
+template <Parser P>
+std::size_t parse_batch(const P& parser, std::span<const Input> inputs,
+                        std::span<detail::batch_value_t<P>> outputs, std::span<std::uint64_t> parsed,
+                        thread_pool& pool) {
+  constexpr auto shard = detail::min_batch_size;
+  std::size_t blocks = (inputs.size() + shard - 1) / shard;
+  std::size_t shards = std::min(pool.size() * 8, blocks);
+  if (shards <= 1) {
+    return parse_batch(parser, inputs, outputs, parsed);
+  }
+
+  std::vector<std::size_t> successes(shards);
+  pool.for_each(shards, [&](std::size_t i) {
+    auto begin = std::min(blocks * i / shards * shard, inputs.size());
+    auto end = std::min(blocks * (i + 1) / shards * shard, inputs.size());
+    successes[i] = detail::parse_batch(parser, inputs, outputs, parsed, begin, end);
+  });
+  return std::accumulate(successes.begin(), successes.end(), std::size_t{ 0 });
+}
+
+// parse_parallel on a pool of all hardware threads.
+template <Parser P, typename Boundary>
+  requires std::same_as<Boundary, char> || Parser<Boundary>
+Result<std::vector<invoke_parser_result_t<P>>> parse_parallel(
+    const P& parser, const Input& input, const Boundary& boundary) {
+  thread_pool pool;
+  return parse_parallel(parser, input, boundary, pool);
+}
+
+}  // namespace parsec
\ No newline at end of file
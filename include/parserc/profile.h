@@ -0,0 +1,279 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "combinator.h"
+#include "trait.h"
+
+// named() wraps parsers to be profiled only if PARSEC_PROFILE is defined to 1,
+// e.g. with -DPARSEC_PROFILE=1. It must be the same in every translation unit.
+#ifndef PARSEC_PROFILE
+#define PARSEC_PROFILE 0
+#endif
+
+namespace parsec {
+
+class profiler;
+
+namespace detail {
+
+// the profiler that named() parsers of this thread record into, if any.
+inline thread_local profiler* current_profiler = nullptr;
+
+// dense ids for the names of rules.
+inline std::atomic<std::uint32_t> next_rule_id = 0;
+
+template <fixed_string Name>
+std::uint32_t rule_id() {
+  static const std::uint32_t id = next_rule_id++;
+  return id;
+}
+
+}  // namespace detail
+
+// the counters and the time of the named() parsers during a parse. While a profiler
+// is alive it is used by the named() parsers of its thread. Profilers nest, the
+// innermost one is used.
+class profiler {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  struct stats {
+    std::string_view name;
+    std::uint64_t calls = 0;
+    std::uint64_t successes = 0;
+    std::uint64_t failures = 0;
+    // failures after consuming input, which the enclosing parsers backtrack from.
+    std::uint64_t backtracks = 0;
+    // the bytes consumed by the successes.
+    std::uint64_t bytes = 0;
+    // the time of the outermost calls, so a recursive rule is not counted twice.
+    clock::duration time{};
+  };
+
+  profiler() : previous_(detail::current_profiler) {
+    detail::current_profiler = this;
+    nodes_.push_back({});
+  }
+
+  profiler(const profiler&) = delete;
+  profiler& operator=(const profiler&) = delete;
+
+  ~profiler() {
+    detail::current_profiler = previous_;
+  }
+
+  // forgets every call.
+  void reset() {
+    stats_.clear();
+    depths_.clear();
+    nodes_.assign(1, {});
+    current_ = 0;
+  }
+
+  // the stats of the rules that were called.
+  std::vector<stats> rules() const {
+    std::vector<stats> ret;
+    for (auto& s : stats_) {
+      if (s.calls > 0) {
+        ret.push_back(s);
+      }
+    }
+    return ret;
+  }
+
+  // the stats of a rule, or empty ones if it was not called.
+  stats rule(std::string_view name) const {
+    for (auto& s : stats_) {
+      if (s.name == name) {
+        return s;
+      }
+    }
+    return stats{ name };
+  }
+
+  // writes a table of the rules, the slowest first.
+  void report(std::ostream& out) const {
+    auto list = rules();
+    std::sort(list.begin(), list.end(), [](const stats& a, const stats& b) {
+      return a.time > b.time;
+    });
+    std::size_t width = 4;
+    for (auto& s : list) {
+      width = std::max(width, s.name.size());
+    }
+
+    out << std::left << std::setw(static_cast<int>(width)) << "rule" << std::right << std::setw(12) << "calls"
+        << std::setw(12) << "successes" << std::setw(12) << "failures" << std::setw(12) << "backtracks"
+        << std::setw(14) << "bytes" << std::setw(14) << "time(us)" << '\n';
+    for (auto& s : list) {
+      auto us = std::chrono::duration_cast<std::chrono::microseconds>(s.time).count();
+      out << std::left << std::setw(static_cast<int>(width)) << s.name << std::right << std::setw(12) << s.calls
+          << std::setw(12) << s.successes << std::setw(12) << s.failures << std::setw(12) << s.backtracks
+          << std::setw(14) << s.bytes << std::setw(14) << us << '\n';
+    }
+  }
+
+  // writes the self time of each stack of rules in nanoseconds as folded stacks,
+  // "json;value;object 1234" per line, the input of flamegraph.pl and speedscope.
+  void flame(std::ostream& out) const {
+    for (std::size_t i = 1; i < nodes_.size(); i++) {
+      auto self = nodes_[i].time;
+      for (auto child : nodes_[i].children) {
+        self -= nodes_[child].time;
+      }
+
+      std::string stack;
+      for (auto n = i; n != 0; n = nodes_[n].parent) {
+        auto name = stats_[nodes_[n].rule].name;
+        stack.insert(0, stack.empty() ? std::string(name) : std::string(name) + ';');
+      }
+      out << stack << ' ' << std::chrono::duration_cast<std::chrono::nanoseconds>(self).count() << '\n';
+    }
+  }
+
+  // records a call of a rule, the result of parse().
+  template <typename F>
+  auto call(std::uint32_t rule, std::string_view name, const Input& input, const F& parse) {
+    if (rule >= stats_.size()) {
+      stats_.resize(rule + 1);
+      depths_.resize(rule + 1);
+    }
+    stats_[rule].name = name;
+    stats_[rule].calls++;
+
+    // the parse may add rules and nodes, so they are found again after it.
+    auto node = child(current_, rule);
+    auto begin = clock::now();
+    auto result = [&] {
+      call_guard guard(*this, rule, node);
+      return parse();
+    }();
+    auto elapsed = clock::now() - begin;
+
+    auto& s = stats_[rule];
+    nodes_[node].time += elapsed;
+    if (depths_[rule] == 0) {
+      s.time += elapsed;
+    }
+    if (result.has_value()) {
+      s.successes++;
+      s.bytes += input.size() - std::get<1>(result.value()).size();
+    } else {
+      s.failures++;
+      if (result.error().remaining < input.size()) {
+        s.backtracks++;
+      }
+    }
+    return result;
+  }
+
+ private:
+  // enters the node of a call while it is alive, also if the parse throws.
+  class call_guard {
+   public:
+    call_guard(profiler& p, std::uint32_t rule, std::size_t node) : p_(p), rule_(rule), parent_(p.current_) {
+      p_.current_ = node;
+      p_.depths_[rule_]++;
+    }
+    call_guard(const call_guard&) = delete;
+    call_guard& operator=(const call_guard&) = delete;
+    ~call_guard() {
+      p_.depths_[rule_]--;
+      p_.current_ = parent_;
+    }
+
+   private:
+    profiler& p_;
+    std::uint32_t rule_;
+    std::size_t parent_;
+  };
+
+  // a stack of rules in the tree of calls, the root is no rule.
+  struct node {
+    std::uint32_t rule = 0;
+    std::size_t parent = 0;
+    std::vector<std::size_t> children;
+    clock::duration time{};
+  };
+
+  std::size_t child(std::size_t parent, std::uint32_t rule) {
+    for (auto i : nodes_[parent].children) {
+      if (nodes_[i].rule == rule) {
+        return i;
+      }
+    }
+    nodes_.push_back({ rule, parent, {}, {} });
+    nodes_[parent].children.push_back(nodes_.size() - 1);
+    return nodes_.size() - 1;
+  }
+
+  profiler* previous_;
+  std::vector<stats> stats_;
+  std::vector<std::uint32_t> depths_;
+  std::vector<node> nodes_;
+  std::size_t current_ = 0;
+};
+
+namespace detail {
+
+template <fixed_string Name, typename P>
+struct named_parser {
+  static constexpr charmap first = first_v<P>;
+  static constexpr bool nullable = nullable_v<P>;
+
+  P parser;
+
+  constexpr auto operator()(const Input& input) const {
+    if !consteval {
+      if (current_profiler != nullptr) {
+        return current_profiler->call(rule_id<Name>(), Name, input, [&]() {
+          return parser(input);
+        });
+      }
+    }
+    return parser(input);
+  }
+};
+
+template <typename P>
+struct is_named_parser : std::false_type {};
+
+template <fixed_string Name, typename P>
+struct is_named_parser<named_parser<Name, P>> : std::true_type {};
+
+// a named parser keeps in a sequence what its parser would, so that naming a
+// sequence does not nest its values.
+template <fixed_string Name, typename P>
+struct kept_values<named_parser<Name, P>> : kept_values<P> {};
+
+template <fixed_string Name, typename... Ps>
+struct kept_values<named_parser<Name, seq_parser<Ps...>>> {
+  using type = seq_parser<Ps...>::values_type;
+};
+
+}  // namespace detail
+
+// names a parser as a rule of the current profiler, e.g. named<"value">(parser),
+// which records its calls, successes, failures, backtracks, consumed bytes and
+// time. Unless PARSEC_PROFILE is 1 it returns the parser itself, so it costs
+// nothing. Either way a grammar has the same values, and optimize() and
+// regular() see through the names.
+template <fixed_string Name, Parser P>
+constexpr auto named(P&& parser) {
+#if PARSEC_PROFILE
+  return detail::named_parser<Name, std::decay_t<P>>{ std::forward<P>(parser) };
+#else
+  return std::decay_t<P>(std::forward<P>(parser));
+#endif
+}
+
+}  // namespace parsec
\ No newline at end of file
@@ -0,0 +1,386 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "character.h"
+#include "combinator.h"
+#include "profile.h"
+#include "token.h"
+
+namespace parsec {
+
+namespace detail {
+
+// a nondeterministic automaton with epsilon transitions, built from a grammar.
+class nfa {
+ public:
+  constexpr std::size_t add_state() {
+    epsilons_.emplace_back();
+    edges_.emplace_back();
+    return epsilons_.size() - 1;
+  }
+
+  constexpr void epsilon(std::size_t from, std::size_t to) { epsilons_[from].push_back(to); }
+
+  constexpr void edge(std::size_t from, std::size_t to, const charmap& map) { edges_[from].push_back({ map, to }); }
+
+  constexpr std::size_t size() const { return epsilons_.size(); }
+
+  struct transition {
+    charmap map;
+    std::size_t to;
+  };
+
+  constexpr const std::vector<std::size_t>& epsilons(std::size_t state) const { return epsilons_[state]; }
+  constexpr const std::vector<transition>& edges(std::size_t state) const { return edges_[state]; }
+
+ private:
+  std::vector<std::vector<std::size_t>> epsilons_;
+  std::vector<std::vector<transition>> edges_;
+};
+
+// the automaton of a grammar from `from` to `to`. Grammars are regular if they are
+// built from sets of characters, literals, seq, choice, many, skip, slice and
+// named.
+template <typename P>
+struct regular_node : std::false_type {};
+
+template <charmap M>
+struct regular_node<charset<M>> : std::true_type {
+  static constexpr void build(nfa& a, std::size_t from, std::size_t to) { a.edge(from, to, M); }
+};
+
+template <fixed_string S>
+struct regular_node<literal<S>> : std::true_type {
+  static constexpr void build(nfa& a, std::size_t from, std::size_t to) {
+    std::string_view text = S;
+    if (text.empty()) {
+      a.epsilon(from, to);
+      return;
+    }
+    for (std::size_t i = 0; i < text.size(); i++) {
+      auto next = i + 1 == text.size() ? to : a.add_state();
+      a.edge(from, next, charmap::of(text[i]));
+      from = next;
+    }
+  }
+};
+
+template <typename... Ps>
+  requires(regular_node<Ps>::value && ...)
+struct regular_node<seq_parser<Ps...>> : std::true_type {
+  static constexpr void build(nfa& a, std::size_t from, std::size_t to) {
+    std::size_t i = 0;
+    auto step = [&]<typename P>() {
+      auto next = ++i == sizeof...(Ps) ? to : a.add_state();
+      regular_node<P>::build(a, from, next);
+      from = next;
+    };
+    (step.template operator()<Ps>(), ...);
+  }
+};
+
+template <typename... Ps>
+  requires(regular_node<Ps>::value && ...)
+struct regular_node<choice_parser<Ps...>> : std::true_type {
+  static constexpr void build(nfa& a, std::size_t from, std::size_t to) { (regular_node<Ps>::build(a, from, to), ...); }
+};
+
+template <typename List, typename P>
+  requires regular_node<P>::value
+struct regular_node<many_parser<List, P>> : std::true_type {
+  static constexpr void build(nfa& a, std::size_t from, std::size_t to) {
+    auto loop = a.add_state();
+    auto next = a.add_state();
+    a.epsilon(from, loop);
+    regular_node<P>::build(a, loop, next);
+    a.epsilon(next, loop);
+    a.epsilon(loop, to);
+  }
+};
+
+template <template <typename> typename Wrapper, typename P>
+  requires regular_node<P>::value && (std::same_as<Wrapper<P>, skipped<P>> || std::same_as<Wrapper<P>, spliced<P>> ||
+                                      std::same_as<Wrapper<P>, sliced<P>>)
+struct regular_node<Wrapper<P>> : std::true_type {
+  static constexpr void build(nfa& a, std::size_t from, std::size_t to) { regular_node<P>::build(a, from, to); }
+};
+
+template <fixed_string Name, typename P>
+  requires regular_node<P>::value
+struct regular_node<named_parser<Name, P>> : std::true_type {
+  static constexpr void build(nfa& a, std::size_t from, std::size_t to) { regular_node<P>::build(a, from, to); }
+};
+
+// a minimized deterministic automaton as a dense table. Characters that no set
+// of the grammar tells apart share one class, so a state has a row of `Classes`
+// transitions instead of 256. A state is the offset of its row, so that a step
+// is one load; state 0 is dead, a transition to it means no match.
+template <std::size_t States, std::size_t Classes>
+struct dfa {
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  std::array<std::uint8_t, 256> class_of{};
+  std::array<std::uint16_t, States * Classes> next{};
+  std::array<bool, States * Classes> accept{};
+  std::uint16_t start = 0;
+
+  // the length of the longest match at the start of an input, or npos.
+  constexpr std::size_t match(const Input& input) const {
+    std::size_t state = start;
+    std::size_t ret = accept[state] ? 0 : npos;
+    for (std::size_t i = 0; i < input.size(); i++) {
+      state = next[state + class_of[static_cast<unsigned char>(input[i])]];
+      if (state == 0) {
+        break;
+      }
+      if (accept[state]) {
+        ret = i + 1;
+      }
+    }
+    return ret;
+  }
+};
+
+// the automaton of a grammar as it is built: the classes of characters, the
+// subset construction and the minimization.
+class dfa_builder {
+ public:
+  template <typename P>
+  static constexpr dfa_builder of() {
+    nfa a;
+    auto start = a.add_state();
+    auto accept = a.add_state();
+    regular_node<P>::build(a, start, accept);
+    return dfa_builder(a, start, accept);
+  }
+
+  constexpr std::size_t states() const { return accept_.size(); }
+  constexpr std::size_t classes() const { return classes_; }
+
+  template <std::size_t States, std::size_t Classes>
+  constexpr dfa<States, Classes> get() const {
+    dfa<States, Classes> ret;
+    ret.class_of = class_of_;
+    for (std::size_t i = 0; i < States * Classes; i++) {
+      ret.next[i] = static_cast<std::uint16_t>(next_[i] * Classes);
+      ret.accept[i] = accept_[i / Classes];
+    }
+    ret.start = static_cast<std::uint16_t>(start_ * Classes);
+    return ret;
+  }
+
+ private:
+  using subset = std::vector<std::uint64_t>;
+
+  constexpr dfa_builder(const nfa& a, std::size_t start, std::size_t accept) {
+    split_classes(a);
+
+    // the subset construction, with the empty subset as the dead state 0.
+    std::vector<subset> subsets{ subset((a.size() + 63) / 64) };
+    std::vector<std::size_t> next;
+    std::vector<bool> accepts{ false };
+    auto find = [&](const subset& s) {
+      for (std::size_t i = 0; i < subsets.size(); i++) {
+        if (subsets[i] == s) {
+          return i;
+        }
+      }
+      subsets.push_back(s);
+      accepts.push_back(((s[accept / 64] >> (accept % 64)) & 1) != 0);
+      return subsets.size() - 1;
+    };
+
+    subset initial(subsets[0].size());
+    add(a, initial, start);
+    std::size_t first = find(initial);
+    for (std::size_t i = 0; i < subsets.size(); i++) {
+      for (std::size_t k = 0; k < classes_; k++) {
+        subset moved(subsets[0].size());
+        for (std::size_t state = 0; state < a.size(); state++) {
+          if (((subsets[i][state / 64] >> (state % 64)) & 1) == 0) {
+            continue;
+          }
+          for (auto& edge : a.edges(state)) {
+            if (edge.map.contains(static_cast<char>(representative_[k]))) {
+              add(a, moved, edge.to);
+            }
+          }
+        }
+        next.push_back(find(moved));
+      }
+    }
+
+    minimize(next, accepts, first);
+  }
+
+  // adds a state and the ones it reaches by epsilon transitions to a subset.
+  static constexpr void add(const nfa& a, subset& s, std::size_t state) {
+    if ((s[state / 64] >> (state % 64)) & 1) {
+      return;
+    }
+    s[state / 64] |= std::uint64_t{ 1 } << (state % 64);
+    for (auto to : a.epsilons(state)) {
+      add(a, s, to);
+    }
+  }
+
+  // splits the characters into the classes that every set of the grammar
+  // either contains or excludes whole.
+  constexpr void split_classes(const nfa& a) {
+    classes_ = 1;
+    for (std::size_t state = 0; state < a.size(); state++) {
+      for (auto& edge : a.edges(state)) {
+        std::array<int, 512> split{};
+        split.fill(-1);
+        std::size_t classes = 0;
+        for (int c = 0; c < 256; c++) {
+          auto& id = split[class_of_[c] * 2 + edge.map.contains(static_cast<char>(c))];
+          if (id < 0) {
+            id = static_cast<int>(classes++);
+          }
+          class_of_[c] = static_cast<std::uint8_t>(id);
+        }
+        classes_ = classes;
+      }
+    }
+    for (int c = 255; c >= 0; c--) {
+      representative_[class_of_[c]] = static_cast<unsigned char>(c);
+    }
+  }
+
+  // merges the states that accept the same inputs (Moore's algorithm), keeping
+  // the dead state at 0.
+  constexpr void minimize(const std::vector<std::size_t>& next, const std::vector<bool>& accepts, std::size_t first) {
+    auto n = accepts.size();
+    std::vector<std::size_t> block(n);
+    for (std::size_t i = 0; i < n; i++) {
+      block[i] = accepts[i] ? 1 : 0;
+    }
+
+    std::size_t blocks = 0;
+    while (true) {
+      // states stay together if their blocks and the blocks they move to agree.
+      std::vector<std::size_t> refined(n);
+      std::size_t count = 0;
+      for (std::size_t i = 0; i < n; i++) {
+        std::size_t j = 0;
+        for (; j < i; j++) {
+          bool same = block[i] == block[j];
+          for (std::size_t k = 0; same && k < classes_; k++) {
+            same = block[next[i * classes_ + k]] == block[next[j * classes_ + k]];
+          }
+          if (same) {
+            break;
+          }
+        }
+        refined[i] = j < i ? refined[j] : count++;
+      }
+      block = refined;
+      if (count == blocks) {
+        break;
+      }
+      blocks = count;
+    }
+
+    // the block of the dead state becomes 0 and the others follow in order.
+    std::vector<std::size_t> id(blocks, blocks);
+    std::size_t ids = 0;
+    id[block[0]] = ids++;
+    for (std::size_t i = 0; i < n; i++) {
+      if (id[block[i]] == blocks) {
+        id[block[i]] = ids++;
+      }
+    }
+
+    next_.assign(blocks * classes_, 0);
+    accept_.assign(blocks, false);
+    for (std::size_t i = 0; i < n; i++) {
+      auto state = id[block[i]];
+      accept_[state] = accepts[i];
+      for (std::size_t k = 0; k < classes_; k++) {
+        next_[state * classes_ + k] = static_cast<std::uint16_t>(id[block[next[i * classes_ + k]]]);
+      }
+    }
+    start_ = static_cast<std::uint16_t>(id[block[first]]);
+  }
+
+  std::array<std::uint8_t, 256> class_of_{};
+  std::array<unsigned char, 256> representative_{};
+  std::size_t classes_ = 1;
+  std::vector<std::uint16_t> next_;
+  std::vector<bool> accept_;
+  std::uint16_t start_ = 0;
+};
+
+// the number of states and of classes of the automaton of a grammar.
+struct dfa_size {
+  std::size_t states;
+  std::size_t classes;
+};
+
+template <typename P>
+constexpr dfa_size size_of_dfa() {
+  auto builder = dfa_builder::of<P>();
+  return { builder.states(), builder.classes() };
+}
+
+// the automaton of a grammar, built once for its size and once for its table,
+// as the vectors of the builder cannot outlive a constant evaluation.
+template <typename P>
+struct regular_dfa {
+  static constexpr dfa_size size = size_of_dfa<P>();
+  static constexpr std::size_t states = size.states;
+  static constexpr std::size_t classes = size.classes;
+  static_assert(states * classes <= UINT16_MAX, "too many states.");
+  // the classes split the 256 characters, so a class id fits in a byte.
+  static_assert(classes <= 256, "too many classes.");
+
+  static constexpr dfa<states, classes> value = dfa_builder::of<P>().template get<states, classes>();
+};
+
+// matches the longest prefix of the input in the language of a regular grammar.
+template <typename P>
+struct regular_parser {
+  static constexpr auto& table = regular_dfa<P>::value;
+
+  // the characters with a transition from the start state.
+  static constexpr charmap first = [] {
+    charmap map;
+    for (int c = 0; c < 256; c++) {
+      if (table.next[table.start + table.class_of[c]] != 0) {
+        map = map | charmap::of(static_cast<char>(c));
+      }
+    }
+    return map;
+  }();
+  static constexpr bool nullable = table.accept[table.start];
+
+  constexpr auto operator()(const Input& input) const {
+    using R = ParserResult<Input>;
+    auto n = table.match(input);
+    if (n == table.npos) {
+      return R{ std::unexpect, input, "regular dismatches." };
+    }
+    return R{ { input.substr(0, n), input.substr(n) } };
+  }
+};
+
+}  // namespace detail
+
+// compiles a regular grammar, built from sets of characters, literals, seq,
+// choice, many, skip and slice, into a minimized DFA at compile time, and
+// matches it with one table lookup per character. Return the matched slice of
+// the input. It matches the longest prefix in the language of the grammar, like
+// a regular expression, where the grammar itself would stop at the first
+// alternative that matches and repeat greedily without backtracking; both agree
+// on grammars whose alternatives do not prefix each other, e.g. timestamps.
+template <Parser P>
+  requires detail::regular_node<std::decay_t<P>>::value
+constexpr auto regular(P&&) {
+  return detail::regular_parser<std::decay_t<P>>{};
+}
+
+}  // namespace parsec
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+#include "trait.h"
+
+namespace parsec {
+
+namespace detail {
+
+// the rules being parsed on this thread, for the depth guard of rule.
+inline thread_local std::size_t rule_depth = 0;
+
+// counts a rule being parsed while it is alive, also if the parse throws.
+class rule_depth_guard {
+ public:
+  rule_depth_guard() { rule_depth++; }
+  rule_depth_guard(const rule_depth_guard&) = delete;
+  rule_depth_guard& operator=(const rule_depth_guard&) = delete;
+  ~rule_depth_guard() { rule_depth--; }
+};
+
+}  // namespace detail
+
+// a parser of T declared before its definition, so that grammars can refer to
+// themselves, e.g. a value that contains arrays of values. A rule refers to its
+// definition, which must outlive it, through a pointer and a function of the
+// definition type, so parsing through it costs one indirect call and no
+// allocation. The copies that combinators take refer to the original rule, which
+// must not be moved. Nested rules deeper than the limit fail instead of
+// overflowing the stack.
+template <typename T>
+class rule {
+ public:
+  // the default depth limit of nested rules.
+  static constexpr std::size_t default_max_depth = 1024;
+
+  explicit rule(std::size_t max_depth = default_max_depth) : max_depth_(max_depth) {}
+
+  rule(const rule& other) : target_(other.target_), max_depth_(other.max_depth_) {}
+
+  rule& operator=(const rule&) = delete;
+
+  // defines the rule as a parser, which is not copied.
+  template <Parser P>
+    requires(!std::same_as<std::remove_cvref_t<P>, rule>)
+  rule& operator=(const P& parser) {
+    definition_ = &parser;
+    call_ = [](const void* definition, const Input& input) -> ParserResult<T> {
+      return (*static_cast<const P*>(definition))(input);
+    };
+    return *this;
+  }
+
+  // a temporary would not outlive the rule.
+  template <Parser P>
+    requires(!std::is_lvalue_reference_v<P>)
+  rule& operator=(P&&) = delete;
+
+  ParserResult<T> operator()(const Input& input) const {
+    using R = ParserResult<T>;
+    if (target_->call_ == nullptr) {
+      return R{ std::unexpect, input, "rule is not defined." };
+    }
+    if (detail::rule_depth >= target_->max_depth_) {
+      return R{ std::unexpect, input, "rule is nested too deep." };
+    }
+
+    detail::rule_depth_guard guard;
+    return target_->call_(target_->definition_, input);
+  }
+
+ private:
+  const rule* target_ = this;
+  const void* definition_ = nullptr;
+  ParserResult<T> (*call_)(const void*, const Input&) = nullptr;
+  std::size_t max_depth_;
+};
+
+}  // namespace parsec
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PARSEC_SCAN_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARSEC_SCAN_SSE2 1
+#endif
+
+#include "trait.h"
+
+namespace parsec {
+
+namespace detail {
+
+// a set of characters as a list of disjoint ranges [begin, end].
+struct charranges {
+  std::size_t size = 0;
+  std::array<std::array<unsigned char, 2>, 128> ranges{};
+};
+
+constexpr charranges ranges_of(const charmap& map) {
+  charranges ret;
+  for (int c = 0; c < 256; c++) {
+    if (!map.contains(static_cast<char>(c))) {
+      continue;
+    }
+    if (ret.size != 0 && ret.ranges[ret.size - 1][1] == c - 1) {
+      ret.ranges[ret.size - 1][1] = static_cast<unsigned char>(c);
+    } else {
+      ret.ranges[ret.size++] = { static_cast<unsigned char>(c), static_cast<unsigned char>(c) };
+    }
+  }
+  return ret;
+}
+
+template <charmap M>
+inline constexpr charranges ranges_v = ranges_of(M);
+
+// sets made of more ranges than this are scanned by table lookups.
+inline constexpr std::size_t max_vector_ranges = 6;
+
+template <charmap M>
+constexpr std::size_t scan_scalar(const Input& input, std::size_t i) {
+  while (i < input.size() && M.contains(input[i])) {
+    i++;
+  }
+  return i;
+}
+
+#if PARSEC_SCAN_SSE2
+// a byte is in [begin, end] iff byte - begin <= end - begin as unsigned bytes.
+template <charmap M>
+inline __m128i match16(__m128i chunk) {
+  constexpr auto& ranges = ranges_v<M>;
+
+  __m128i match = _mm_setzero_si128();
+  for (std::size_t i = 0; i < ranges.size; i++) {
+    auto begin = _mm_set1_epi8(static_cast<char>(ranges.ranges[i][0]));
+    auto span = _mm_set1_epi8(static_cast<char>(ranges.ranges[i][1] - ranges.ranges[i][0]));
+    auto offset = _mm_sub_epi8(chunk, begin);
+    match = _mm_or_si128(match, _mm_cmpeq_epi8(_mm_min_epu8(offset, span), offset));
+  }
+  return match;
+}
+#endif
+
+#if PARSEC_SCAN_AVX2
+template <charmap M>
+inline __m256i match32(__m256i chunk) {
+  constexpr auto& ranges = ranges_v<M>;
+
+  __m256i match = _mm256_setzero_si256();
+  for (std::size_t i = 0; i < ranges.size; i++) {
+    auto begin = _mm256_set1_epi8(static_cast<char>(ranges.ranges[i][0]));
+    auto span = _mm256_set1_epi8(static_cast<char>(ranges.ranges[i][1] - ranges.ranges[i][0]));
+    auto offset = _mm256_sub_epi8(chunk, begin);
+    match = _mm256_or_si256(match, _mm256_cmpeq_epi8(_mm256_min_epu8(offset, span), offset));
+  }
+  return match;
+}
+#endif
+
+}  // namespace detail
+
+// returns the length of the longest prefix of the input whose characters are all in M.
+// At runtime, it tests 32 (AVX2) or 16 (SSE2) characters at a time.
+template <charmap M>
+constexpr std::size_t scan(const Input& input) {
+  if consteval {
+    return detail::scan_scalar<M>(input, 0);
+  } else {
+    std::size_t i = 0;
+    if constexpr (detail::ranges_v<M>.size <= detail::max_vector_ranges) {
+      [[maybe_unused]] const char* data = input.data();
+      [[maybe_unused]] const std::size_t size = input.size();
+#if PARSEC_SCAN_AVX2
+      for (; i + 32 <= size; i += 32) {
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(detail::match32<M>(chunk)));
+        if (mask != 0xFFFFFFFF) {
+          return i + std::countr_one(mask);
+        }
+      }
+#endif
+#if PARSEC_SCAN_SSE2
+      for (; i + 16 <= size; i += 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto mask = static_cast<std::uint16_t>(_mm_movemask_epi8(detail::match16<M>(chunk)));
+        if (mask != 0xFFFF) {
+          return i + std::countr_one(mask);
+        }
+      }
+#endif
+    }
+    return detail::scan_scalar<M>(input, i);
+  }
+}
+
+}  // namespace parsec
\ No newline at end of file
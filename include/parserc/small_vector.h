@@ -0,0 +1,103 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace parsec {
+
+// a list that keeps up to N elements inline and moves them to the heap beyond
+// that, the result of many<small_vector<T, N>> and friends for short repetitions.
+// It is usable in constant evaluation, so T must be default constructible.
+template <typename T, std::size_t N>
+class small_vector {
+ public:
+  using value_type = T;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  constexpr small_vector() = default;
+
+  constexpr small_vector(std::initializer_list<T> list) {
+    for (auto& value : list) {
+      push_back(value);
+    }
+  }
+
+  // the elements are stored inline.
+  constexpr bool is_inline() const { return heap_.empty(); }
+
+  constexpr std::size_t size() const { return size_; }
+  constexpr bool empty() const { return size_ == 0; }
+  static constexpr std::size_t inline_capacity() { return N; }
+
+  constexpr T* data() { return is_inline() ? inline_.data() : heap_.data(); }
+  constexpr const T* data() const { return is_inline() ? inline_.data() : heap_.data(); }
+
+  constexpr iterator begin() { return data(); }
+  constexpr iterator end() { return data() + size_; }
+  constexpr const_iterator begin() const { return data(); }
+  constexpr const_iterator end() const { return data() + size_; }
+
+  constexpr T& operator[](std::size_t i) { return data()[i]; }
+  constexpr const T& operator[](std::size_t i) const { return data()[i]; }
+
+  constexpr T& front() { return data()[0]; }
+  constexpr const T& front() const { return data()[0]; }
+  constexpr T& back() { return data()[size_ - 1]; }
+  constexpr const T& back() const { return data()[size_ - 1]; }
+
+  template <typename... Args>
+  constexpr T& emplace_back(Args&&... args) {
+    if (size_ < N && heap_.empty()) {
+      inline_[size_] = T(std::forward<Args>(args)...);
+      return inline_[size_++];
+    }
+    if (heap_.empty()) {
+      // the arguments may refer to an inline element, so it is built before they move.
+      T value(std::forward<Args>(args)...);
+      heap_.reserve(N * 2 + 1);
+      std::move(inline_.begin(), inline_.end(), std::back_inserter(heap_));
+      heap_.push_back(std::move(value));
+      size_++;
+      return heap_.back();
+    }
+    heap_.emplace_back(std::forward<Args>(args)...);
+    size_++;
+    return heap_.back();
+  }
+
+  constexpr void push_back(const T& value) { emplace_back(value); }
+  constexpr void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  // the vacated inline slots are reset, so that they release what they own.
+  constexpr void pop_back() {
+    if (is_inline()) {
+      inline_[size_ - 1] = T{};
+    } else {
+      heap_.pop_back();
+    }
+    size_--;
+  }
+
+  constexpr void clear() {
+    std::fill(inline_.begin(), inline_.begin() + std::min(size_, N), T{});
+    heap_.clear();
+    size_ = 0;
+  }
+
+  friend constexpr bool operator==(const small_vector& a, const small_vector& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end());
+  }
+
+ private:
+  std::array<T, N> inline_{};
+  // every element once there are more than N.
+  std::vector<T> heap_;
+  std::size_t size_ = 0;
+};
+
+}  // namespace parsec
\ No newline at end of file
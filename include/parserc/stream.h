@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+#include "trait.h"
+
+namespace parsec {
+
+// parses a stream of records fed in chunks of bytes, e.g. read from a socket.
+// A record is one match of the parser. A record that fails at the end of the bytes
+// fed so far, e.g. inside a literal or a keyword, needs more input, so it waits
+// for the next chunk and is parsed again from its start. Completed records are never parsed again, and their bytes are
+// released before the next chunk is buffered, so the memory is bounded by the
+// longest record plus a chunk.
+// A match is a complete record as soon as it succeeds, so records must know where
+// they end, e.g. with a delimiter: a bare number cut by a chunk would be taken as
+// two records.
+template <Parser P>
+class stream {
+ public:
+  using value_type = invoke_parser_result_t<P>;
+
+  explicit constexpr stream(P parser) : parser_(std::move(parser)) {}
+
+  // appends a chunk and passes each complete record to f. Values that view the
+  // input are valid only during the call to f. Return the number of records or
+  // the error of the first record that fails.
+  template <std::invocable<value_type> F>
+  constexpr Result<std::size_t> feed(const Input& chunk, F&& f) {
+    release();
+    buffer_.append(chunk);
+    return parse(f);
+  }
+
+  // the end of the stream: parses the records left, and fails if some bytes are
+  // not a record.
+  template <std::invocable<value_type> F>
+  constexpr Result<std::size_t> finish(F&& f) {
+    finished_ = true;
+    return parse(f);
+  }
+
+  // the bytes of the incomplete record that waits for more input.
+  constexpr Input pending() const {
+    return Input(buffer_).substr(begin_);
+  }
+
+  // the offset of the next record in the whole stream.
+  constexpr std::size_t consumed() const {
+    return released_ + begin_;
+  }
+
+  // the offset of an error of feed or finish in the whole stream.
+  constexpr std::size_t offset(const Error& error) const {
+    return released_ + buffer_.size() - error.remaining;
+  }
+
+ private:
+  template <typename F>
+  constexpr Result<std::size_t> parse(F& f) {
+    std::size_t records = 0;
+    while (begin_ < buffer_.size()) {
+      Input input = pending();
+      auto result = parser_(input);
+      if (!result.has_value()) {
+        if (!finished_ && result.error().remaining == 0) {
+          break;
+        }
+        return Result<std::size_t>{ std::unexpect, result.error() };
+      }
+
+      auto rest = std::get<1>(result.value());
+      if (rest.size() == input.size()) {
+        return Result<std::size_t>{ std::unexpect, input, "stream record is empty." };
+      }
+      f(std::get<0>(std::move(result).value()));
+      begin_ += input.size() - rest.size();
+      records++;
+    }
+    return records;
+  }
+
+  // drops the bytes of the completed records.
+  constexpr void release() {
+    buffer_.erase(0, begin_);
+    released_ += begin_;
+    begin_ = 0;
+    if (buffer_.capacity() > 4 * buffer_.size() + max_idle_capacity) {
+      buffer_.shrink_to_fit();
+    }
+  }
+
+  // the unused buffer capacity kept between chunks.
+  static constexpr std::size_t max_idle_capacity = 1 << 16;
+
+  P parser_;
+  std::string buffer_;
+  std::size_t begin_ = 0;
+  std::size_t released_ = 0;
+  bool finished_ = false;
+};
+
+}  // namespace parsec
\ No newline at end of file
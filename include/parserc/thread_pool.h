@@ -0,0 +1,158 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace parsec {
+
+// a pool of threads that run the tasks of a parallel loop. Each thread takes the
+// tasks of its own queue from the front and, when it runs out, steals tasks from
+// the back of the other queues, so uneven tasks still keep every thread busy.
+class thread_pool {
+ public:
+  // a pool of `threads` threads, the one calling for_each included.
+  explicit thread_pool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+      : queues_(std::max<std::size_t>(threads, 1)) {
+    for (std::size_t i = 1; i < queues_.size(); i++) {
+      workers_.emplace_back([this, i] { work(i); });
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  std::size_t size() const { return queues_.size(); }
+
+  // calls f(i) for each i in [0, n) on the pool and waits for all of them.
+  // Loops run one at a time and must not be nested. If f throws, the tasks not
+  // started yet are dropped and the first exception is rethrown here.
+  template <typename F>
+  void for_each(std::size_t n, F&& f) {
+    if (n == 0) {
+      return;
+    }
+
+    std::lock_guard loop(loop_mutex_);
+    {
+      std::lock_guard lock(mutex_);
+      call_ = [](void* context, std::size_t i) { (*static_cast<std::remove_reference_t<F>*>(context))(i); };
+      context_ = const_cast<void*>(static_cast<const void*>(&f));
+      pending_ = n;
+      // contiguous ranges of tasks, so neighbouring tasks run on one thread.
+      for (std::size_t q = 0; q < queues_.size(); q++) {
+        std::lock_guard queue_lock(queues_[q].mutex);
+        for (std::size_t i = n * q / queues_.size(); i < n * (q + 1) / queues_.size(); i++) {
+          queues_[q].tasks.push_back(i);
+        }
+      }
+      generation_++;
+    }
+    wake_.notify_all();
+
+    run(0);
+    std::unique_lock lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+    if (failed_) {
+      failed_ = false;
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+  }
+
+ private:
+  struct queue {
+    std::mutex mutex;
+    std::deque<std::size_t> tasks;
+  };
+
+  // pops a task of queue q, or steals one from the back of another queue.
+  bool next(std::size_t q, std::size_t& task) {
+    for (std::size_t k = 0; k < queues_.size(); k++) {
+      auto& queue = queues_[(q + k) % queues_.size()];
+      std::lock_guard lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        if (k == 0) {
+          task = queue.tasks.front();
+          queue.tasks.pop_front();
+        } else {
+          task = queue.tasks.back();
+          queue.tasks.pop_back();
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void run(std::size_t q) {
+    std::size_t task;
+    while (next(q, task)) {
+      // the tasks are still counted down after a failure, so that for_each
+      // waits for the ones running before it rethrows.
+      if (!failed_) {
+        try {
+          call_(context_, task);
+        } catch (...) {
+          std::lock_guard lock(mutex_);
+          if (!failed_) {
+            error_ = std::current_exception();
+            failed_ = true;
+          }
+        }
+      }
+      if (pending_.fetch_sub(1) == 1) {
+        std::lock_guard lock(mutex_);
+        done_.notify_all();
+      }
+    }
+  }
+
+  void work(std::size_t q) {
+    std::size_t seen = 0;
+    while (true) {
+      {
+        std::unique_lock lock(mutex_);
+        wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) {
+          return;
+        }
+        seen = generation_;
+      }
+      run(q);
+    }
+  }
+
+  std::vector<queue> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex loop_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  void (*call_)(void*, std::size_t) = nullptr;
+  void* context_ = nullptr;
+  std::atomic<std::size_t> pending_ = 0;
+  // a task threw, error_ is the first exception.
+  std::atomic<bool> failed_ = false;
+  std::exception_ptr error_;
+  std::size_t generation_ = 0;
+  bool stop_ = false;
+};
+
+}  // namespace parsec
\ No newline at end of file
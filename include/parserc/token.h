@@ -1,46 +1,335 @@
-#pragma once
-#include "character.h"
-#include "combinator.h"
-
-namespace parsec {
-
-constexpr auto symbol(const Input& token) {
-  using R = ParserResult<std::string_view>;
-  return [token](const std::string_view& input) {
-    if (input.starts_with(token)) {
-      auto rest = input.substr(token.size());
-      return R{ { token, rest } };
-    }
-    return R{ std::unexpect, "symbol dismatches." };
-  };
-}
-
-template <typename T>
-constexpr auto decimal = many1(digit) | map([](auto&& result) {
-  T value = 0;
-  for (auto c : result) {
-    value *= 10;
-    value += c - '0';
-  }
-  return value;
-});
-
-// matches a parser enclosed in parentheses: []
-template <Parser P>
-constexpr auto squares(P&& parser) {
-  return between(one_of<'['>, parser, one_of<']'>);
-}
-
-// matches a parser enclosed in parentheses: {}
-template <Parser P>
-constexpr auto brackets(P&& parser) {
-  return between(one_of<'{'>, parser, one_of<'}'>);
-}
-
-// matches a parser enclosed in parentheses: ()
-template <Parser P>
-constexpr auto parentheses(P&& parser) {
-  return between(one_of<'('>, parser, one_of<')'>);
-}
-
+#pragma once
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+#include "character.h"
+#include "combinator.h"
+#include "floating.h"
+#include "trie.h"
+
+namespace parsec {
+
+constexpr auto symbol(const Input& token) {
+  using R = ParserResult<std::string_view>;
+  return [token](const std::string_view& input) {
+    if (input.starts_with(token)) {
+      auto rest = input.substr(token.size());
+      return R{ { token, rest } };
+    }
+    // an input cut inside the token fails at its end, where more input could match.
+    return R{ std::unexpect, token.starts_with(input) ? input.substr(input.size()) : input, "symbol dismatches." };
+  };
+}
+
+namespace detail {
+
+// matches a string known at compile time, see lit.
+template <fixed_string S>
+struct literal {
+  static constexpr std::string_view text = S;
+  static constexpr charmap first = text.empty() ? charmap{} : charmap::of(text[0]);
+  static constexpr bool nullable = text.empty();
+
+  constexpr auto operator()(const Input& input) const {
+    using R = ParserResult<std::string_view>;
+    if (!input.starts_with(text)) {
+      // an input cut inside the literal fails at its end, where more input could match.
+      return R{ std::unexpect, text.starts_with(input) ? input.substr(input.size()) : input, "literal dismatches." };
+    }
+    return R{ { input.substr(0, text.size()), input.substr(text.size()) } };
+  }
+};
+
+}  // namespace detail
+
+// matches a string known at compile time, like symbol. Return the matched slice
+// of the input. Skipped literals next to each other in a sequence are merged by
+// optimize.
+template <fixed_string S>
+constexpr auto lit = detail::literal<S>{};
+
+// matches the longest of the keywords and returns its index in the list.
+// All keywords are tested in one pass over the input by a trie built at compile time.
+template <fixed_string... Keywords>
+constexpr auto keywords = detail::annotate<detail::keyword_trie<Keywords...>::first,
+                                           detail::keyword_trie<Keywords...>::nullable>([](const Input& input) {
+  using R = ParserResult<std::size_t>;
+  auto [index, length, cut] = detail::keyword_trie<Keywords...>::value.match(input);
+  if (index == detail::trie_match::npos) {
+    return R{ std::unexpect, cut ? input.substr(input.size()) : input, "keywords dismatches." };
+  }
+  return R{ { index, input.substr(length) } };
+});
+
+// matches the longest of the symbols, like symbol(a) || symbol(b) || ... but in one pass.
+template <fixed_string... Symbols>
+constexpr auto symbols = detail::annotate<detail::keyword_trie<Symbols...>::first,
+                                          detail::keyword_trie<Symbols...>::nullable>([](const Input& input) {
+  using R = ParserResult<std::string_view>;
+  auto [index, length, cut] = detail::keyword_trie<Symbols...>::value.match(input);
+  if (index == detail::trie_match::npos) {
+    return R{ std::unexpect, cut ? input.substr(input.size()) : input, "symbols dismatches." };
+  }
+  return R{ { input.substr(0, length), input.substr(length) } };
+});
+
+namespace detail {
+
+// the value of a digit in 0-9, a-f or A-F, without branches.
+constexpr std::uint64_t digit_value(char c) {
+  return (c & 0xF) + 9 * ((c >> 6) & 1);
+}
+
+// sets the high bit of every byte of an 8-byte word that is in [begin, end].
+constexpr std::uint64_t bytes_in_range(std::uint64_t word, unsigned char begin, unsigned char end) {
+  constexpr std::uint64_t ones = 0x0101010101010101;
+  std::uint64_t low = word & (ones * 0x7F);
+  std::uint64_t ge_begin = low + ones * (0x80 - begin);
+  std::uint64_t gt_end = low + ones * (0x7F - end);
+  return ge_begin & ~gt_end & ~word & (ones * 0x80);
+}
+
+// converts 8 decimal digits at once (SWAR), or returns false if one is not a digit.
+constexpr bool eight_decimal_digits(std::uint64_t word, std::uint64_t& value) {
+  if (bytes_in_range(word, '0', '9') != 0x8080808080808080) {
+    return false;
+  }
+  word -= 0x3030303030303030;
+  word = (word * 10) + (word >> 8);
+  value = (((word & 0x000000FF000000FF) * 0x000F424000000064) +
+              (((word >> 16) & 0x000000FF000000FF) * 0x0000271000000001)) >>
+          32;
+  return true;
+}
+
+// converts 8 hexadecimal digits at once (SWAR), or returns false if one is not a digit.
+constexpr bool eight_hexadecimal_digits(std::uint64_t word, std::uint64_t& value) {
+  if ((bytes_in_range(word, '0', '9') | bytes_in_range(word | 0x2020202020202020, 'a', 'f')) != 0x8080808080808080) {
+    return false;
+  }
+  word = (word & 0x0F0F0F0F0F0F0F0F) + 9 * ((word >> 6) & 0x0101010101010101);
+  word = ((word & 0x0F000F000F000F00) >> 8) | ((word & 0x000F000F000F000F) << 4);
+  word = ((word & 0x00FF000000FF0000) >> 16) | ((word & 0x000000FF000000FF) << 8);
+  value = ((word & 0x0000FFFF00000000) >> 32) | ((word & 0x000000000000FFFF) << 16);
+  return true;
+}
+
+// accumulates the leading Digits of the input in Base into value modulo 2^64,
+// 8 digits at a time at runtime. Return the number of digits.
+template <int Base, charmap Digits>
+constexpr std::size_t accumulate(const Input& input, std::uint64_t& value) {
+  std::size_t i = 0;
+  if !consteval {
+    if constexpr (std::endian::native == std::endian::little && Base != 8) {
+      constexpr std::uint64_t scale = Base == 10 ? 100000000 : 0x100000000;
+      std::uint64_t word, eight;
+      for (; i + 8 <= input.size(); i += 8) {
+        std::memcpy(&word, input.data() + i, sizeof(word));
+        if (!(Base == 10 ? eight_decimal_digits(word, eight) : eight_hexadecimal_digits(word, eight))) {
+          break;
+        }
+        value = value * scale + eight;
+      }
+    }
+  }
+  for (; i < input.size() && Digits.contains(input[i]); i++) {
+    value = value * Base + digit_value(input[i]);
+  }
+  return i;
+}
+
+// the number of digits in Base that always fit in std::uint64_t.
+template <int Base>
+constexpr std::size_t safe_digits = Base == 10 ? 19 : Base == 16 ? 16 : 21;
+
+// Base ^ safe_digits<Base>, the smallest number of safe_digits<Base> + 1 digits.
+// 16 ^ 16 does not fit, no hexadecimal number of 17 digits does either.
+template <int Base>
+constexpr std::uint64_t smallest_unsafe = Base == 10 ? 10000000000000000000u : Base == 8 ? std::uint64_t{ 1 } << 63 : 0;
+
+// converts digits in Base to T, or std::nullopt if the value overflows T.
+// value is the digits accumulated modulo 2^64.
+template <std::integral T, int Base>
+constexpr std::optional<T> to_integer(Input digits, std::uint64_t value, bool negative) {
+  using U = std::make_unsigned_t<T>;
+  constexpr std::uint64_t max = std::numeric_limits<T>::max();
+  const std::uint64_t limit = negative ? max + 1 : max;
+
+  while (digits.size() > 1 && digits[0] == '0') {
+    digits.remove_prefix(1);
+  }
+  if (digits.size() > safe_digits<Base>) {
+    // only numbers starting with 1 fit, then value wrapped iff it became smaller.
+    if (Base == 16 || digits.size() > safe_digits<Base> + 1 || digits[0] != '1' || value < smallest_unsafe<Base>) {
+      return std::nullopt;
+    }
+  }
+  if (value > limit) {
+    return std::nullopt;
+  }
+
+  if (negative) {
+    return static_cast<T>(U(0) - static_cast<U>(value));
+  }
+  return static_cast<T>(value);
+}
+
+// matches a number made of Digits in Base, signed T accepts a leading sign.
+template <std::integral T, int Base, charmap Digits>
+constexpr auto integer() {
+  using R = ParserResult<T>;
+  constexpr charmap first = std::is_signed_v<T> ? Digits | sign.map : Digits;
+
+  return detail::annotate<first, false>([](const Input& input) {
+    Input rest = input;
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+      if (auto result = sign(rest)) {
+        negative = std::get<0>(result.value()) == '-';
+        rest = std::get<1>(result.value());
+      }
+    }
+
+    std::uint64_t value = 0;
+    auto n = accumulate<Base, Digits>(rest, value);
+    if (n == 0) {
+      return R{ std::unexpect, rest, "number dismatches." };
+    }
+
+    auto result = to_integer<T, Base>(rest.substr(0, n), value, negative);
+    if (!result.has_value()) {
+      return R{ std::unexpect, rest, "number overflows." };
+    }
+    return R{ { *result, rest.substr(n) } };
+  });
+}
+
+// matches a floating point number: [sign] digits [. digits] [(e|E) [sign] digits],
+// where either the integer or the fraction digits may be empty.
+template <typename T>
+constexpr auto floating() {
+  using R = ParserResult<T>;
+  constexpr charmap first = digit.map | sign.map | dot.map;
+
+  return detail::annotate<first, false>([](const Input& input) {
+    Input rest = input;
+    bool negative = false;
+    if (auto result = sign(rest)) {
+      negative = std::get<0>(result.value()) == '-';
+      rest = std::get<1>(result.value());
+    }
+    const Input number = rest;
+
+    Input integer = rest.substr(0, scan<digit.map>(rest));
+    Input fraction;
+    rest.remove_prefix(integer.size());
+    if (auto result = dot(rest)) {
+      rest = std::get<1>(result.value());
+      fraction = rest.substr(0, scan<digit.map>(rest));
+      rest.remove_prefix(fraction.size());
+    }
+    if (integer.empty() && fraction.empty()) {
+      return R{ std::unexpect, number, "number dismatches." };
+    }
+
+    // the exponent saturates, any larger one overflows or underflows T anyway.
+    int exponent = 0;
+    if (!rest.empty() && (rest[0] | 0x20) == 'e') {
+      Input digits = rest.substr(1);
+      bool negative_exponent = false;
+      if (auto result = sign(digits)) {
+        negative_exponent = std::get<0>(result.value()) == '-';
+        digits = std::get<1>(result.value());
+      }
+      if (auto n = scan<digit.map>(digits); n != 0) {
+        for (auto c : digits.substr(0, n)) {
+          exponent = std::min(exponent * 10 + (c - '0'), 100000);
+        }
+        exponent = negative_exponent ? -exponent : exponent;
+        rest = digits.substr(n);
+      }
+    }
+    const Input text = number.substr(0, number.size() - rest.size());
+
+    // the first 19 significant digits, value = mantissa * 10^scale.
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int scale = exponent;
+    bool truncated = false;
+    for (auto c : integer) {
+      if (digits < 19 && (digits != 0 || c != '0')) {
+        mantissa = mantissa * 10 + (c - '0');
+        digits += 1;
+      } else if (digits != 0) {
+        scale += 1;
+        truncated = truncated || c != '0';
+      }
+    }
+    for (auto c : fraction) {
+      if (digits < 19 && (digits != 0 || c != '0')) {
+        mantissa = mantissa * 10 + (c - '0');
+        digits += 1;
+        scale -= 1;
+      } else if (digits == 0) {
+        scale -= 1;
+      } else {
+        truncated = truncated || c != '0';
+      }
+    }
+
+    T value = 0;
+    if (mantissa != 0 && (truncated || !fast_float(mantissa, scale, value))) {
+      if consteval {
+        value = big_decimal(integer, fraction, exponent).to_float<T>(false);
+      } else {
+        auto [_, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec == std::errc::result_out_of_range) {
+          value = scale + digits > 0 ? std::numeric_limits<T>::infinity() : 0;
+        }
+      }
+    }
+    return R{ { negative ? -value : value, rest } };
+  });
+}
+
+}  // namespace detail
+
+// matches a octal number, fails if it overflows T.
+template <std::integral T>
+constexpr auto octal = detail::integer<T, 8, octdigit.map>();
+
+// matches a decimal number, fails if it overflows T.
+template <std::integral T>
+constexpr auto decimal = detail::integer<T, 10, digit.map>();
+
+// matches a hexadecimal number, fails if it overflows T.
+template <std::integral T>
+constexpr auto hexadecimal = detail::integer<T, 16, hexdigit.map>();
+
+// matches a floating point number in JSON or C syntax, correctly rounded to T.
+// Values beyond the range of T become infinity or zero.
+template <typename T>
+  requires std::same_as<T, float> || std::same_as<T, double>
+constexpr auto floating = detail::floating<T>();
+
+// matches a parser enclosed in parentheses: []
+template <Parser P>
+constexpr auto squares(P&& parser) {
+  return between(one_of<'['>, parser, one_of<']'>);
+}
+
+// matches a parser enclosed in parentheses: {}
+template <Parser P>
+constexpr auto brackets(P&& parser) {
+  return between(one_of<'{'>, parser, one_of<'}'>);
+}
+
+// matches a parser enclosed in parentheses: ()
+template <Parser P>
+constexpr auto parentheses(P&& parser) {
+  return between(one_of<'('>, parser, one_of<')'>);
+}
+
 }  // namespace parsec
\ No newline at end of file
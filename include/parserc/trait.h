@@ -1,73 +1,245 @@
-#pragma once
-#include <concepts>
-#include <expected>
-#include <optional>
-#include <string_view>
-
-namespace parsec {
-
-template <typename R, typename F, typename... Args>
-concept invocable_r = std::invocable<F, Args...> &&
-                      std::same_as<std::invoke_result_t<F, Args...>, R>;
-
-template <typename T, typename E>
-class expected : public std::expected<T, E> {
- public:
-  using std::expected<T, E>::expected;
-
-  template <std::invocable<T> F>
-  constexpr auto map(F&& f) const& {
-    using R = std::invoke_result_t<F, T>;
-
-    if (this->has_value()) {
-      return expected<R, E>(std::invoke(std::forward<F>(f), this->value()));
-    } else {
-      return expected<R, E>(std::unexpect, this->error());
-    }
-  }
-
-  template <std::invocable<T> F>
-  constexpr auto and_then(F&& f) const& {
-    using R = std::invoke_result_t<F, T>;
-
-    if (this->has_value()) {
-      return std::invoke(std::forward<F>(f), this->value());
-    } else {
-      return R(std::unexpect, this->error());
-    }
-  }
-
-  template <std::invocable<> F>
-  constexpr auto or_else(F&& f) const& {
-    if (this->has_value()) {
-      return *this;
-    } else {
-      return std::invoke(std::forward<F>(f));
-    }
-  }
-};
-
-using Input = std::string_view;
-using Error = std::string_view;
-
-template <typename F>
-concept Parser = std::invocable<F, Input>;
-
-template <typename T>
-using Output = std::tuple<T, Input>;
-
-template <typename T>
-using Result = expected<T, Error>;
-
-using ParserError = std::unexpected<Error>;
-
-template <typename T>
-using ParserResult = Result<Output<T>>;
-
-template <Parser P>
-using invoke_parser_output_t = std::invoke_result_t<P, Input>::value_type;
-template <Parser P>
-using invoke_parser_result_t =
-    std::tuple_element_t<0, invoke_parser_output_t<P>>;
-
+#pragma once
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace parsec {
+
+template <typename R, typename F, typename... Args>
+concept invocable_r = std::invocable<F, Args...> &&
+                      std::same_as<std::invoke_result_t<F, Args...>, R>;
+
+template <typename T, typename E>
+class expected : public std::expected<T, E> {
+ public:
+  using std::expected<T, E>::expected;
+
+  template <std::invocable<T> F>
+  constexpr auto map(F&& f) const& {
+    using R = std::invoke_result_t<F, T>;
+
+    if (this->has_value()) {
+      return expected<R, E>(std::invoke(std::forward<F>(f), this->value()));
+    } else {
+      return expected<R, E>(std::unexpect, this->error());
+    }
+  }
+
+  template <std::invocable<T> F>
+  constexpr auto map(F&& f) && {
+    using R = std::invoke_result_t<F, T>;
+
+    if (this->has_value()) {
+      return expected<R, E>(std::invoke(std::forward<F>(f), std::move(*this).value()));
+    } else {
+      return expected<R, E>(std::unexpect, std::move(*this).error());
+    }
+  }
+
+  template <std::invocable<T> F>
+  constexpr auto and_then(F&& f) const& {
+    using R = std::invoke_result_t<F, T>;
+
+    if (this->has_value()) {
+      return std::invoke(std::forward<F>(f), this->value());
+    } else {
+      return R(std::unexpect, this->error());
+    }
+  }
+
+  template <std::invocable<T> F>
+  constexpr auto and_then(F&& f) && {
+    using R = std::invoke_result_t<F, T>;
+
+    if (this->has_value()) {
+      return std::invoke(std::forward<F>(f), std::move(*this).value());
+    } else {
+      return R(std::unexpect, std::move(*this).error());
+    }
+  }
+
+  template <std::invocable<> F>
+  constexpr auto or_else(F&& f) const& {
+    if (this->has_value()) {
+      return *this;
+    } else {
+      return std::invoke(std::forward<F>(f));
+    }
+  }
+
+  template <std::invocable<> F>
+  constexpr auto or_else(F&& f) && {
+    if (this->has_value()) {
+      return std::move(*this);
+    } else {
+      return std::invoke(std::forward<F>(f));
+    }
+  }
+};
+
+using Input = std::string_view;
+
+// the line and the column of a position in an input, both counted from 1.
+struct Location {
+  std::size_t line = 1;
+  std::size_t column = 1;
+
+  friend constexpr bool operator==(const Location&, const Location&) = default;
+};
+
+// a parse failure: where it happened and what was expected there. The position is
+// kept as the length of the input left, so an error is as cheap to make as a
+// string_view and the offset is known in any input the failing input is a suffix of.
+struct Error {
+  std::size_t remaining = 0;
+  std::string_view expected;
+  // the failure is past a commit, so choices and repetitions fail with it instead
+  // of trying other alternatives, see commit.
+  bool committed = false;
+
+  constexpr Error() = default;
+
+  // a failure at the start of the input.
+  constexpr Error(const Input& input, std::string_view expected)
+      : remaining(input.size()), expected(expected) {}
+
+  // the byte offset of the failure in the input the parse started with.
+  constexpr std::size_t offset(const Input& input) const {
+    return input.size() - remaining;
+  }
+
+  // the line and the column of the failure in the input the parse started with.
+  constexpr Location location(const Input& input) const {
+    auto before = input.substr(0, offset(input));
+    Location ret;
+    for (auto c : before) {
+      ret.line += c == '\n';
+    }
+    auto newline = before.rfind('\n');
+    ret.column = before.size() - (newline == Input::npos ? 0 : newline + 1) + 1;
+    return ret;
+  }
+
+  // formats the failure as "line:column: expected".
+  std::string message(const Input& input) const {
+    auto [line, column] = location(input);
+    return std::to_string(line) + ":" + std::to_string(column) + ": " + std::string(expected);
+  }
+
+  // the failure further into the input, the later one if both are at the same place.
+  friend constexpr const Error& furthest(const Error& a, const Error& b) {
+    return b.remaining <= a.remaining ? b : a;
+  }
+
+  friend constexpr bool operator==(const Error&, const Error&) = default;
+};
+
+template <typename F>
+concept Parser = std::invocable<F, Input>;
+
+template <typename T>
+using Output = std::tuple<T, Input>;
+
+template <typename T>
+using Result = expected<T, Error>;
+
+using ParserError = std::unexpected<Error>;
+
+template <typename T>
+using ParserResult = Result<Output<T>>;
+
+template <Parser P>
+using invoke_parser_output_t = std::invoke_result_t<P, Input>::value_type;
+template <Parser P>
+using invoke_parser_result_t =
+    std::tuple_element_t<0, invoke_parser_output_t<P>>;
+
+// a set of characters stored as a 256-bit bitmap.
+struct charmap {
+  std::array<std::uint64_t, 4> bits{};
+
+  // the set of characters in the range [begin, end].
+  static constexpr charmap range(char begin, char end) {
+    charmap map;
+    for (int c = static_cast<unsigned char>(begin); c <= static_cast<unsigned char>(end); c++) {
+      map.bits[c >> 6] |= std::uint64_t{ 1 } << (c & 63);
+    }
+    return map;
+  }
+
+  // the set of the given characters.
+  template <std::same_as<char>... Chars>
+  static constexpr charmap of(Chars... chs) {
+    return (charmap{} | ... | range(chs, chs));
+  }
+
+  constexpr bool contains(char c) const {
+    auto u = static_cast<unsigned char>(c);
+    return (bits[u >> 6] >> (u & 63)) & 1;
+  }
+
+  constexpr charmap operator~() const {
+    return { { ~bits[0], ~bits[1], ~bits[2], ~bits[3] } };
+  }
+
+  friend constexpr charmap operator|(const charmap& a, const charmap& b) {
+    return { { a.bits[0] | b.bits[0], a.bits[1] | b.bits[1], a.bits[2] | b.bits[2], a.bits[3] | b.bits[3] } };
+  }
+
+  friend constexpr charmap operator&(const charmap& a, const charmap& b) {
+    return { { a.bits[0] & b.bits[0], a.bits[1] & b.bits[1], a.bits[2] & b.bits[2], a.bits[3] & b.bits[3] } };
+  }
+
+  friend constexpr bool operator==(const charmap&, const charmap&) = default;
+};
+
+// the characters a parser can start a match with, and whether it can match
+// without consuming input. Parsers declare them as static members `first` and
+// `nullable`, others are assumed to start with any character or be empty.
+template <typename P>
+struct first_set {
+  static constexpr charmap value = ~charmap{};
+  static constexpr bool nullable = true;
+};
+
+template <typename P>
+  requires requires {
+    { std::remove_cvref_t<P>::first } -> std::convertible_to<charmap>;
+    { std::remove_cvref_t<P>::nullable } -> std::convertible_to<bool>;
+  }
+struct first_set<P> {
+  static constexpr charmap value = std::remove_cvref_t<P>::first;
+  static constexpr bool nullable = std::remove_cvref_t<P>::nullable;
+};
+
+template <typename P>
+inline constexpr charmap first_v = first_set<P>::value;
+
+template <typename P>
+inline constexpr bool nullable_v = first_set<P>::nullable;
+
+// a string literal usable as a template argument, e.g. keywords<"GET", "PUT">.
+template <std::size_t N>
+struct fixed_string {
+  char data[N]{};
+
+  constexpr fixed_string() = default;
+
+  constexpr fixed_string(const char (&str)[N]) {
+    for (std::size_t i = 0; i < N; i++) {
+      data[i] = str[i];
+    }
+  }
+
+  constexpr std::size_t size() const { return N - 1; }
+
+  constexpr operator std::string_view() const { return { data, N - 1 }; }
+};
+
 }  // namespace parsec
\ No newline at end of file
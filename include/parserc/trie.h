@@ -0,0 +1,163 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "trait.h"
+
+namespace parsec {
+
+namespace detail {
+
+// the longest keyword matched at the start of an input.
+struct trie_match {
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  std::size_t index = npos;
+  std::size_t length = 0;
+  // the input ends inside a keyword, so more input could match a longer one.
+  bool cut = false;
+};
+
+// a trie of keywords as a dense state machine. Characters that appear in no
+// keyword share one class, so a state has a row of `classes` transitions
+// instead of 256. State 0 is the root, and a transition to 0 means no match.
+// The keywords may use all 256 characters besides the class of the others, so a
+// class takes two bytes.
+template <std::size_t Nodes, std::size_t Classes>
+struct trie {
+  std::array<std::uint16_t, 256> class_of{};
+  std::array<std::uint16_t, Nodes * Classes> next{};
+  // the index + 1 of the keyword that ends at a state, or 0.
+  std::array<std::uint16_t, Nodes> accept{};
+
+  constexpr trie_match match(const Input& input) const {
+    trie_match ret;
+    if (accept[0] != 0) {
+      ret = { accept[0] - 1u, 0, false };
+    }
+    std::size_t node = 0;
+    for (std::size_t i = 0; i < input.size(); i++) {
+      node = next[node * Classes + class_of[static_cast<unsigned char>(input[i])]];
+      if (node == 0) {
+        return ret;
+      }
+      if (accept[node] != 0) {
+        ret = { accept[node] - 1u, i + 1, false };
+      }
+    }
+    ret.cut = true;
+    return ret;
+  }
+};
+
+// the characters used by the keywords.
+template <std::size_t N>
+constexpr charmap alphabet_of(const std::array<std::string_view, N>& keywords) {
+  charmap map;
+  for (auto keyword : keywords) {
+    for (auto c : keyword) {
+      map = map | charmap::of(c);
+    }
+  }
+  return map;
+}
+
+template <std::size_t N>
+constexpr std::size_t classes_of(const std::array<std::string_view, N>& keywords) {
+  auto map = alphabet_of(keywords);
+  std::size_t classes = 1;
+  for (int c = 0; c < 256; c++) {
+    classes += map.contains(static_cast<char>(c));
+  }
+  return classes;
+}
+
+// the states of a trie as it is built, one row of transitions per state.
+class trie_builder {
+ public:
+  template <std::size_t N>
+  constexpr explicit trie_builder(const std::array<std::string_view, N>& keywords) {
+    auto map = alphabet_of(keywords);
+    for (int c = 0; c < 256; c++) {
+      if (map.contains(static_cast<char>(c))) {
+        class_of_[c] = static_cast<std::uint16_t>(classes_++);
+      }
+    }
+
+    // at most a node per character of the keywords, so the rows are not copied
+    // as they grow.
+    std::size_t chars = 0;
+    for (auto keyword : keywords) {
+      chars += keyword.size();
+    }
+    next_.reserve((1 + chars) * classes_);
+    next_.resize(classes_);
+    accept_.resize(1);
+    for (std::size_t k = 0; k < N; k++) {
+      std::size_t node = 0;
+      for (auto c : keywords[k]) {
+        auto edge = node * classes_ + class_of_[static_cast<unsigned char>(c)];
+        if (next_[edge] == 0) {
+          next_[edge] = static_cast<std::uint16_t>(accept_.size());
+          next_.resize(next_.size() + classes_);
+          accept_.push_back(0);
+        }
+        node = next_[edge];
+      }
+      // a repeated keyword keeps its first index.
+      if (accept_[node] == 0) {
+        accept_[node] = static_cast<std::uint16_t>(k + 1);
+      }
+    }
+  }
+
+  constexpr std::size_t nodes() const { return accept_.size(); }
+
+  template <std::size_t Nodes, std::size_t Classes>
+  constexpr trie<Nodes, Classes> get() const {
+    trie<Nodes, Classes> ret;
+    ret.class_of = class_of_;
+    for (std::size_t i = 0; i < Nodes * Classes; i++) {
+      ret.next[i] = next_[i];
+    }
+    for (std::size_t i = 0; i < Nodes; i++) {
+      ret.accept[i] = accept_[i];
+    }
+    return ret;
+  }
+
+ private:
+  std::array<std::uint16_t, 256> class_of_{};
+  std::size_t classes_ = 1;
+  std::vector<std::uint16_t> next_;
+  std::vector<std::uint16_t> accept_;
+};
+
+template <fixed_string... Keywords>
+struct keyword_trie {
+  static constexpr std::array<std::string_view, sizeof...(Keywords)> keywords{ Keywords... };
+  static constexpr std::size_t classes = classes_of(keywords);
+  static constexpr std::size_t nodes = trie_builder(keywords).nodes();
+  static_assert(nodes <= UINT16_MAX && keywords.size() < UINT16_MAX, "too many keywords.");
+
+  // the first characters of the keywords, and whether one of them is empty.
+  static constexpr bool nullable = ((Keywords.size() == 0) || ...);
+  static constexpr charmap first = [] {
+    charmap map;
+    for (auto keyword : keywords) {
+      if (!keyword.empty()) {
+        map = map | charmap::of(keyword[0]);
+      }
+    }
+    return map;
+  }();
+
+  static constexpr trie<nodes, classes> value = trie_builder(keywords).get<nodes, classes>();
+};
+
+}  // namespace detail
+
+}  // namespace parsec
\ No newline at end of file
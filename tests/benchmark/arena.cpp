@@ -0,0 +1,69 @@
+#include <parserc/arena.h>
+#include <parserc/token.h>
+
+#include "bench.h"
+
+using namespace parsec;
+
+// value := number | '[' value (',' value)* ']'
+// a syntax tree whose lists are std::vector or, with an arena, std::pmr::vector.
+template <bool Arena>
+struct grammar {
+  struct node;
+  using list = std::conditional_t<Arena, std::pmr::vector<node>, std::vector<node>>;
+
+  struct node {
+    int value = 0;
+    list children;
+  };
+
+  static ParserResult<node> value(const Input& input) {
+    static constexpr auto children = [] {
+      if constexpr (Arena) {
+        return pmr::sepby(value, one_of<','>);
+      } else {
+        return sepby(value, one_of<','>);
+      }
+    }();
+    static constexpr auto parse =
+        (decimal<int> | map([](int value) { return node{ value, {} }; })) ||
+        (between(one_of<'['>, children, one_of<']'>) | map([](list children) { return node{ 0, std::move(children) }; }));
+    return parse(input);
+  }
+};
+
+// random lists nested up to 4 levels, of up to 8 values each.
+static void nested_list(std::string& out, auto& rng, int depth) {
+  if (depth == 0 || rng() % 3 == 0) {
+    out.append(std::to_string(rng() % 1000));
+    return;
+  }
+  out.push_back('[');
+  for (std::size_t i = 0, n = rng() % 9; i < n; i++) {
+    if (i != 0) {
+      out.push_back(',');
+    }
+    nested_list(out, rng, depth - 1);
+  }
+  out.push_back(']');
+}
+
+template <bool Arena>
+static void nested_lists(benchmark::State& state) {
+  auto input = bench::generate("nested_list", state.range(0), [](std::string& out, auto& rng) {
+    out.push_back(out.empty() ? '[' : ',');
+    nested_list(out, rng, 4);
+  }) + "]";
+
+  // one arena for every parse, reset keeps its memory.
+  arena a;
+  bench::report report(state);
+  for (auto _ : state) {
+    a.reset();
+    auto result = grammar<Arena>::value(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+BENCHMARK_TEMPLATE(nested_lists, false)->Name("nested_lists")->Apply(bench::large_sizes);
+BENCHMARK_TEMPLATE(nested_lists, true)->Name("nested_lists_arena")->Apply(bench::large_sizes);
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
+#ifndef PARSEC_BENCH_MAX_SIZE
+#define PARSEC_BENCH_MAX_SIZE (1 << 30)
+#endif
+
+namespace bench {
+
+// the smallest and the largest generated input, in bytes.
+constexpr std::int64_t min_size = 1 << 10;
+constexpr std::int64_t max_size = PARSEC_BENCH_MAX_SIZE;
+
+// every allocation made through the global operator new, see main.cpp.
+inline std::atomic<std::size_t> allocations = 0;
+inline std::atomic<std::size_t> allocated_bytes = 0;
+
+// registers input sizes from 1 KB up to max_size.
+inline void sizes(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(32)->Range(min_size, max_size)->Unit(benchmark::kMicrosecond);
+}
+
+// registers input sizes from 1 KB up to 32 MB, for benchmarks whose parsed
+// values take many times the memory of their input.
+inline void large_sizes(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(32)->Range(min_size, std::min<std::int64_t>(max_size, 1 << 25))->Unit(benchmark::kMicrosecond);
+}
+
+// deterministic random engine so every run sees the same inputs.
+inline std::mt19937_64& engine() {
+  static std::mt19937_64 engine(0x5eed);
+  return engine;
+}
+
+// generates an input of at least `size` bytes by appending the output of `gen`.
+// the last generated input is cached, so repeated runs of one benchmark
+// do not pay for the generation again.
+template <typename F>
+const std::string& generate(std::string_view kind, std::size_t size, F&& gen) {
+  static std::string cached_kind;
+  static std::string cached;
+  if (cached_kind != kind || cached.size() < size || cached.size() > size + 64) {
+    cached_kind = kind;
+    cached.clear();
+    cached.shrink_to_fit();
+    cached.reserve(size + 64);
+    engine().seed(0x5eed);
+    while (cached.size() < size) {
+      gen(cached, engine());
+    }
+  }
+  return cached;
+}
+
+// random characters drawn from `alphabet`.
+inline const std::string& chars(std::string_view alphabet, std::size_t size) {
+  return generate(alphabet, size, [alphabet](std::string& out, auto& rng) {
+    out.push_back(alphabet[rng() % alphabet.size()]);
+  });
+}
+
+// measures a benchmark loop and reports throughput, time per parse and
+// allocations per iteration.
+class report {
+ public:
+  explicit report(benchmark::State& state)
+      : state_(state), allocations_(allocations), bytes_(allocated_bytes) {}
+
+  // `bytes` input bytes and `parses` parser invocations per iteration.
+  void done(std::size_t bytes, std::size_t parses = 1) {
+    auto iterations = static_cast<double>(state_.iterations());
+    state_.SetBytesProcessed(state_.iterations() * static_cast<std::int64_t>(bytes));
+    state_.SetItemsProcessed(state_.iterations() * static_cast<std::int64_t>(parses));
+    state_.counters["ns_per_parse"] = benchmark::Counter(
+        static_cast<double>(parses) * iterations / 1e9,
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state_.counters["allocs"] = benchmark::Counter(
+        static_cast<double>(allocations - allocations_),
+        benchmark::Counter::kAvgIterations);
+    state_.counters["alloc_bytes"] = benchmark::Counter(
+        static_cast<double>(allocated_bytes - bytes_),
+        benchmark::Counter::kAvgIterations);
+  }
+
+ private:
+  benchmark::State& state_;
+  std::size_t allocations_;
+  std::size_t bytes_;
+};
+
+}  // namespace bench
\ No newline at end of file
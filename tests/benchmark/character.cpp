@@ -0,0 +1,83 @@
+#include <parserc/character.h>
+
+#include "bench.h"
+
+using namespace parsec;
+
+static void take_while_alphanum(benchmark::State& state) {
+  constexpr auto parse = take_while([](char c) {
+    return ('0' <= c && c <= '9') || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+  });
+  const auto& input = bench::chars("abcdefghijklmnopqrstuvwxyz0123456789", state.range(0));
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+BENCHMARK(take_while_alphanum)->Apply(bench::sizes);
+
+template <Parser P>
+static void hexdigits(benchmark::State& state, P parse) {
+  const auto& input = bench::chars("0123456789abcdefABCDEF", state.range(0));
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+
+static constexpr auto between_chars = [](char begin, char end) {
+  return satisfy([=](char c) {
+    return begin <= c && c <= end;
+  });
+};
+
+BENCHMARK_CAPTURE(hexdigits, table, count(hexdigit))->Apply(bench::sizes);
+BENCHMARK_CAPTURE(hexdigits, choice, count(between_chars('0', '9') || between_chars('A', 'F') || between_chars('a', 'f')))->Apply(bench::sizes);
+
+// long alphanumeric tokens separated by spaces, state.range(0) characters each.
+template <Parser P>
+static void tokens(benchmark::State& state, P parse) {
+  auto length = static_cast<std::size_t>(state.range(0));
+  const auto& input = bench::generate("tokens" + std::to_string(length), bench::max_size < (1 << 26) ? bench::max_size : (1 << 26), [length](std::string& out, auto& rng) {
+    for (std::size_t i = 0; i < length; i++) {
+      out.push_back("abcdefghijklmnopqrstuvwxyz0123456789"[rng() % 36]);
+    }
+    out.push_back(' ');
+  });
+
+  std::size_t parses = 0;
+  bench::report report(state);
+  for (auto _ : state) {
+    parses = 0;
+    Input rest = input;
+    while (!rest.empty()) {
+      auto result = parse(rest);
+      benchmark::DoNotOptimize(result);
+      rest = std::get<1>(result.value()).substr(1);
+      parses++;
+    }
+  }
+  report.done(input.size(), parses);
+}
+
+// alphanum hidden behind a lambda, so many goes through the generic path.
+static constexpr auto opaque_alphanum = [](const Input& input) {
+  return alphanum(input);
+};
+
+static void token_lengths(benchmark::internal::Benchmark* b) {
+  b->Arg(16)->Arg(64)->Arg(256)->Arg(4096)->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK_CAPTURE(tokens, take_while, take_while(alphanum))->Apply(token_lengths);
+BENCHMARK_CAPTURE(tokens, many, many(alphanum))->Apply(token_lengths);
+BENCHMARK_CAPTURE(tokens, many_generic, many(opaque_alphanum))->Apply(token_lengths);
+BENCHMARK_CAPTURE(tokens, take_while_predicate, take_while([](char c) {
+  return alphanum.map.contains(c);
+}))->Apply(token_lengths);
\ No newline at end of file
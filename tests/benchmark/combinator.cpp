@@ -0,0 +1,259 @@
+#include <parserc/character.h>
+#include <parserc/combinator.h>
+#include <parserc/token.h>
+
+#include <utility>
+
+#include "bench.h"
+
+using namespace parsec;
+
+static void many_alphanum(benchmark::State& state) {
+  constexpr auto parse = many(alphanum);
+  const auto& input = bench::chars("abcdefghijklmnopqrstuvwxyz0123456789", state.range(0));
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+BENCHMARK(many_alphanum)->Apply(bench::sizes);
+
+static void many1_digit(benchmark::State& state) {
+  constexpr auto parse = many1(digit);
+  const auto& input = bench::chars("0123456789", state.range(0));
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+BENCHMARK(many1_digit)->Apply(bench::sizes);
+
+static void sepby_words(benchmark::State& state) {
+  constexpr auto parse = sepby(many1(lower), comma);
+  const auto& input = bench::generate("words", state.range(0), [](std::string& out, auto& rng) {
+    if (!out.empty()) {
+      out.push_back(',');
+    }
+    out.append(1 + rng() % 12, static_cast<char>('a' + rng() % 26));
+  });
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+BENCHMARK(sepby_words)->Apply(bench::sizes);
+
+static void choice_chain(benchmark::State& state) {
+  constexpr auto letter = one_of<'a'> || one_of<'b'> || one_of<'c'> || one_of<'d'> ||
+                          one_of<'e'> || one_of<'f'> || one_of<'g'> || one_of<'h'>;
+  constexpr auto parse = many(letter);
+  const auto& input = bench::chars("abcdefgh", state.range(0));
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+BENCHMARK(choice_chain)->Apply(bench::sizes);
+
+static void count_alphanum(benchmark::State& state) {
+  constexpr auto parse = count(alphanum);
+  const auto& input = bench::chars("abcdefghijklmnopqrstuvwxyz0123456789", state.range(0));
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+BENCHMARK(count_alphanum)->Apply(bench::sizes);
+
+static void skip_many_alphanum(benchmark::State& state) {
+  constexpr auto parse = skip_many(alphanum);
+  const auto& input = bench::chars("abcdefghijklmnopqrstuvwxyz0123456789", state.range(0));
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+BENCHMARK(skip_many_alphanum)->Apply(bench::sizes);
+
+// ordered choice that tries every alternative, as choice did before it
+// dispatched on first sets.
+template <Parser P, Parser... Ps>
+constexpr auto ordered(P parser, Ps... parsers) {
+  if constexpr (sizeof...(Ps) == 0) {
+    return parser;
+  } else {
+    return [parser, rest = ordered(parsers...)](const Input& input) {
+      return parser(input).or_else([&]() {
+        return rest(input);
+      });
+    };
+  }
+}
+
+// a 16-way alternation of tagged numbers like "a12 p7 c300".
+template <bool Dispatch>
+static void wide_choice(benchmark::State& state) {
+  constexpr auto tagged = []<std::size_t... I>(std::index_sequence<I...>) {
+    if constexpr (Dispatch) {
+      return (... || right(one_of<static_cast<char>('a' + I)>, decimal<int>));
+    } else {
+      return ordered(right(one_of<static_cast<char>('a' + I)>, decimal<int>)...);
+    }
+  }(std::make_index_sequence<16>{});
+  constexpr auto parse = skip_many(left(tagged, space));
+  const auto& input = bench::generate("tagged", state.range(0), [](std::string& out, auto& rng) {
+    out.push_back(static_cast<char>('a' + rng() % 16));
+    out.append(std::to_string(rng() % 1000));
+    out.push_back(' ');
+  });
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+BENCHMARK_TEMPLATE(wide_choice, true)->Name("wide_choice")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(wide_choice, false)->Name("wide_choice_ordered")->Apply(bench::sizes);
+
+// number ',' number '\n' records collected into a std::vector, or passed to a sink.
+template <bool Sink>
+static void records(benchmark::State& state) {
+  constexpr auto record = left(decimal<int> + right(comma, decimal<int>), one_of<'\n'>);
+  const auto& input = bench::generate("records", state.range(0), [](std::string& out, auto& rng) {
+    out.append(std::to_string(rng() % 100000));
+    out.push_back(',');
+    out.append(std::to_string(rng() % 100000));
+    out.push_back('\n');
+  });
+
+  bench::report report(state);
+  for (auto _ : state) {
+    if constexpr (Sink) {
+      long sum = 0;
+      auto result = many_into(record, [&sum](auto&& r) { sum += std::get<1>(r); })(input);
+      benchmark::DoNotOptimize(result);
+      benchmark::DoNotOptimize(sum);
+    } else {
+      auto result = many(record)(input);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  report.done(input.size());
+}
+BENCHMARK_TEMPLATE(records, false)->Name("records_many")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(records, true)->Name("records_many_into")->Apply(bench::sizes);
+
+// records of 8 comma separated words, as one flat sequence or as sequences
+// nested two at a time, which is what a + b + ... built before seq flattened.
+template <Parser P1, Parser P2>
+constexpr auto nested_seq(P1 parser1, P2 parser2) {
+  return seq(detail::annotate<first_v<P1>, nullable_v<P1>>(parser1), parser2);
+}
+
+template <std::size_t N, Parser P>
+constexpr auto fields(P field) {
+  if constexpr (N == 1) {
+    return field;
+  } else {
+    return nested_seq(fields<N - 1>(field), right(comma, field));
+  }
+}
+
+template <bool Flat>
+static void sequence(benchmark::State& state) {
+  static constexpr auto field = many1(lower);
+  constexpr auto parse = [] {
+    if constexpr (Flat) {
+      return many(left(field + right(comma, field) + right(comma, field) + right(comma, field) +
+                           right(comma, field) + right(comma, field) + right(comma, field) + right(comma, field),
+                       one_of<'\n'>));
+    } else {
+      return many(left(fields<8>(field), one_of<'\n'>));
+    }
+  }();
+  const auto& input = bench::generate("sequence", state.range(0), [](std::string& out, auto& rng) {
+    for (int i = 0; i < 8; i++) {
+      out.append(1 + rng() % 12, static_cast<char>('a' + rng() % 26));
+      out.push_back(i == 7 ? '\n' : ',');
+    }
+  });
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+BENCHMARK_TEMPLATE(sequence, true)->Name("sequence_flat")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(sequence, false)->Name("sequence_nested")->Apply(bench::sizes);
+
+// item := name '{' item* '}' ';' | name '{' item* '}'
+// the alternatives share the prefix up to the block, so without commit a failure
+// inside a block parses it again with the other alternative, at every level.
+template <bool Commit>
+struct nested_items {
+  static inline std::size_t calls = 0;
+
+  static ParserResult<std::size_t> item(const Input& input) {
+    calls++;
+    static constexpr auto body = [] {
+      constexpr auto items = left(count(item), one_of<'}'>);
+      if constexpr (Commit) {
+        return commit(items);
+      } else {
+        return items;
+      }
+    }();
+    static constexpr auto block = seq(skip(skip_many(lower)), skip(one_of<'{'>), body);
+    static constexpr auto parse = left(block, one_of<';'>) || block;
+    return parse(input);
+  }
+};
+
+// items nested `depth` times, with a failure in the innermost one.
+static std::string nested_failure(std::size_t depth) {
+  std::string input = "x{?}";
+  for (std::size_t i = 0; i < depth; i++) {
+    input = "a{" + input + ";}";
+  }
+  return input + ";";
+}
+
+template <bool Commit>
+static void commit_nested(benchmark::State& state) {
+  const auto input = nested_failure(state.range(0));
+
+  std::size_t calls = 0;
+  bench::report report(state);
+  for (auto _ : state) {
+    nested_items<Commit>::calls = 0;
+    auto result = nested_items<Commit>::item(input);
+    benchmark::DoNotOptimize(result);
+    calls = nested_items<Commit>::calls;
+  }
+  state.counters["calls"] = static_cast<double>(calls);
+  report.done(input.size());
+}
+BENCHMARK_TEMPLATE(commit_nested, false)->Name("commit_nested_off")->DenseRange(4, 16, 4);
+BENCHMARK_TEMPLATE(commit_nested, true)->Name("commit_nested")->DenseRange(4, 16, 4);
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <parserc/combinator.h>
+#include <parserc/parallel.h>
+#include <parserc/token.h>
+
+#include "../bench.h"
+
+using namespace parsec;
+
+// the grammar of tests/unittest/examples/ipv4.cpp.
+static constexpr auto ipv4 = [](uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+  return (a << 24) | (b << 16) | (c << 8) | d;
+};
+
+static constexpr auto octet = decimal<uint8_t>;
+static constexpr auto ipv4_addr = eof(sepby<4>(octet, dot));
+static constexpr auto to_ipv4 = ipv4_addr | to([](auto&& result) {
+  auto [a, b, c, d] = result;
+  return ipv4(a, b, c, d);
+});
+
+using address = detail::batch_value_t<decltype(to_ipv4)>;
+
+static const std::string& addresses(std::size_t size) {
+  return bench::generate("ipv4", size, [](std::string& out, auto& rng) {
+    for (int i = 0; i < 4; i++) {
+      out.append(std::to_string(rng() % 256));
+      out.push_back(i == 3 ? '\n' : '.');
+    }
+  });
+}
+
+// the addresses of the input as a batch of small inputs.
+static std::vector<Input> lines(const Input& input) {
+  std::vector<Input> lines;
+  for (Input rest = input; !rest.empty();) {
+    auto line = rest.substr(0, rest.find('\n'));
+    lines.push_back(line);
+    rest.remove_prefix(std::min(line.size() + 1, rest.size()));
+  }
+  return lines;
+}
+
+static void examples_ipv4(benchmark::State& state) {
+  const auto& input = addresses(state.range(0));
+
+  std::size_t parses = 0;
+  bench::report report(state);
+  for (auto _ : state) {
+    parses = 0;
+    Input rest = input;
+    while (!rest.empty()) {
+      auto line = rest.substr(0, rest.find('\n'));
+      benchmark::DoNotOptimize(to_ipv4(line));
+      rest.remove_prefix(line.size() + 1);
+      parses++;
+    }
+  }
+  report.done(input.size(), parses);
+}
+BENCHMARK(examples_ipv4)->Apply(bench::sizes);
+
+// one call at a time over a batch, the baseline of parse_batch.
+static void examples_ipv4_loop(benchmark::State& state) {
+  const auto& input = addresses(state.range(0));
+  auto inputs = lines(input);
+  std::vector<address> outputs(inputs.size());
+  std::vector<bool> parsed(inputs.size());
+
+  bench::report report(state);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+      auto result = to_ipv4(inputs[i]);
+      parsed[i] = result.has_value();
+      if (result.has_value()) {
+        outputs[i] = *result;
+      }
+    }
+    benchmark::DoNotOptimize(outputs.data());
+  }
+  report.done(input.size(), inputs.size());
+}
+BENCHMARK(examples_ipv4_loop)->Apply(bench::sizes);
+
+static void examples_ipv4_batch(benchmark::State& state) {
+  const auto& input = addresses(state.range(0));
+  auto inputs = lines(input);
+  std::vector<address> outputs(inputs.size());
+  std::vector<std::uint64_t> parsed(batch_words(inputs.size()));
+
+  bench::report report(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(parse_batch(to_ipv4, inputs, outputs, parsed));
+  }
+  report.done(input.size(), inputs.size());
+}
+BENCHMARK(examples_ipv4_batch)->Apply(bench::sizes);
+
+static void examples_ipv4_batch_threads(benchmark::State& state) {
+  const auto& input = addresses(state.range(0));
+  auto inputs = lines(input);
+  std::vector<address> outputs(inputs.size());
+  std::vector<std::uint64_t> parsed(batch_words(inputs.size()));
+  thread_pool pool;
+
+  bench::report report(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(parse_batch(to_ipv4, inputs, outputs, parsed, pool));
+  }
+  report.done(input.size(), inputs.size());
+}
+BENCHMARK(examples_ipv4_batch_threads)->Apply(bench::sizes)->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <parserc/character.h>
+#include <parserc/combinator.h>
+#include <parserc/expression.h>
+#include <parserc/token.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "bench.h"
+
+using namespace parsec;
+
+namespace {
+
+using u64 = std::uint64_t;
+
+// the operators of the filter expressions of a rule engine, loosest first.
+constexpr std::array<std::string_view, 12> names = { "||", "&&", "==", "!=", "<=", ">=", "<", ">", "+", "-", "*", "/" };
+
+constexpr std::array table{
+  infix<u64>{ 1, assoc::left, [](u64 a, u64 b) -> u64 { return a || b; } },
+  infix<u64>{ 2, assoc::left, [](u64 a, u64 b) -> u64 { return a && b; } },
+  infix<u64>{ 3, assoc::left, [](u64 a, u64 b) -> u64 { return a == b; } },
+  infix<u64>{ 3, assoc::left, [](u64 a, u64 b) -> u64 { return a != b; } },
+  infix<u64>{ 4, assoc::left, [](u64 a, u64 b) -> u64 { return a <= b; } },
+  infix<u64>{ 4, assoc::left, [](u64 a, u64 b) -> u64 { return a >= b; } },
+  infix<u64>{ 4, assoc::left, [](u64 a, u64 b) -> u64 { return a < b; } },
+  infix<u64>{ 4, assoc::left, [](u64 a, u64 b) -> u64 { return a > b; } },
+  infix<u64>{ 5, assoc::left, [](u64 a, u64 b) -> u64 { return a + b; } },
+  infix<u64>{ 5, assoc::left, [](u64 a, u64 b) -> u64 { return a - b; } },
+  infix<u64>{ 6, assoc::left, [](u64 a, u64 b) -> u64 { return a * b; } },
+  infix<u64>{ 6, assoc::left, [](u64 a, u64 b) -> u64 { return a / b; } },
+};
+
+constexpr auto ws = skip_many(one_of<' '>);
+constexpr auto operand = left(decimal<u64>, ws);
+
+// one level of the hand-nested grammar: lower (op lower)*, folded from the left.
+// Offset is the index of the first operator of the level in the table.
+template <std::size_t Offset, Parser Lower, Parser Op>
+constexpr auto level(Lower lower, Op op) {
+  return (lower + many(left(op, ws) + lower)) | map([](auto&& result) {
+    auto [acc, rest] = std::move(result);
+    for (auto& [index, value] : rest) {
+      acc = table[Offset + index].apply(acc, value);
+    }
+    return acc;
+  });
+}
+
+constexpr auto product = level<10>(operand, keywords<"*", "/">);
+constexpr auto sum = level<8>(product, keywords<"+", "-">);
+constexpr auto relational = level<4>(sum, keywords<"<=", ">=", "<", ">">);
+constexpr auto equality = level<2>(relational, keywords<"==", "!=">);
+constexpr auto conjunction = level<1>(equality, keywords<"&&">);
+constexpr auto nested = level<0>(conjunction, keywords<"||">);
+
+constexpr auto climbing =
+    precedence(operand, left(keywords<"||", "&&", "==", "!=", "<=", ">=", "<", ">", "+", "-", "*", "/">, ws), table);
+
+// lines of filter expressions of 64 operands.
+const std::string& expressions(std::size_t size) {
+  return bench::generate("expressions", size, [](std::string& out, auto& rng) {
+    out += std::to_string(1 + rng() % 999);
+    for (int i = 0; i < 63; i++) {
+      out += ' ';
+      out += names[rng() % names.size()];
+      out += ' ';
+      out += std::to_string(1 + rng() % 999);
+    }
+    out += '\n';
+  });
+}
+
+}  // namespace
+
+template <bool Climbing>
+static void expression_filters(benchmark::State& state) {
+  const auto& input = expressions(state.range(0));
+  const auto parse = [] {
+    if constexpr (Climbing) {
+      return fold_many(left(climbing, one_of<'\n'>), u64{ 0 }, [](u64 acc, u64 value) { return acc + value; });
+    } else {
+      return fold_many(left(nested, one_of<'\n'>), u64{ 0 }, [](u64 acc, u64 value) { return acc + value; });
+    }
+  }();
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+BENCHMARK_TEMPLATE(expression_filters, false)->Name("expression_filters_nested")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(expression_filters, true)->Name("expression_filters_precedence")->Apply(bench::sizes);
\ No newline at end of file
@@ -0,0 +1,258 @@
+#include <parserc/json.h>
+
+#include <charconv>
+
+#include "bench.h"
+
+using namespace parsec;
+
+namespace {
+
+// a hand-written recursive descent parser building the same values, the baseline.
+class handwritten {
+ public:
+  explicit handwritten(Input input) : input_(input) {}
+
+  bool parse(json::value& out) {
+    return value(out) && (skip(), at_ == input_.size());
+  }
+
+ private:
+  void skip() {
+    while (at_ < input_.size() && (input_[at_] == ' ' || input_[at_] == '\n' || input_[at_] == '\r' || input_[at_] == '\t')) {
+      at_++;
+    }
+  }
+
+  bool value(json::value& out) {
+    if (depth_++ > 1024) {
+      return false;
+    }
+    skip();
+    bool ok = false;
+    if (at_ < input_.size()) {
+      switch (input_[at_]) {
+        case '{': ok = object(out); break;
+        case '[': ok = array(out); break;
+        case '"': {
+          json::string s;
+          ok = string(s);
+          out.data = s;
+          break;
+        }
+        case 't': ok = literal("true", out, json::value{ true }); break;
+        case 'f': ok = literal("false", out, json::value{ false }); break;
+        case 'n': ok = literal("null", out, json::value{ nullptr }); break;
+        default: ok = number(out); break;
+      }
+    }
+    depth_--;
+    return ok;
+  }
+
+  bool literal(Input word, json::value& out, json::value v) {
+    if (!input_.substr(at_).starts_with(word)) {
+      return false;
+    }
+    at_ += word.size();
+    out = std::move(v);
+    return true;
+  }
+
+  bool number(json::value& out) {
+    double d;
+    auto begin = input_.data() + at_;
+    auto [end, ec] = std::from_chars(begin, input_.data() + input_.size(), d);
+    if (ec != std::errc() || *begin == '+') {
+      return false;
+    }
+    at_ += end - begin;
+    out.data = d;
+    return true;
+  }
+
+  bool string(json::string& out) {
+    auto begin = ++at_;
+    bool escaped = false;
+    for (; at_ < input_.size(); at_++) {
+      auto c = static_cast<unsigned char>(input_[at_]);
+      if (c == '"') {
+        out = { input_.substr(begin, at_++ - begin), escaped };
+        return true;
+      }
+      if (c == '\\') {
+        escaped = true;
+        at_ += input_[at_ + 1] == 'u' ? 5 : 1;
+      } else if (c < 0x20) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  bool array(json::value& out) {
+    json::array elements;
+    at_++;
+    skip();
+    if (at_ < input_.size() && input_[at_] == ']') {
+      at_++;
+      out.data = std::move(elements);
+      return true;
+    }
+    while (true) {
+      if (!value(elements.emplace_back())) {
+        return false;
+      }
+      skip();
+      if (at_ < input_.size() && input_[at_] == ',') {
+        at_++;
+      } else if (at_ < input_.size() && input_[at_] == ']') {
+        at_++;
+        out.data = std::move(elements);
+        return true;
+      } else {
+        return false;
+      }
+    }
+  }
+
+  bool object(json::value& out) {
+    json::object members;
+    at_++;
+    skip();
+    if (at_ < input_.size() && input_[at_] == '}') {
+      at_++;
+      out.data = std::move(members);
+      return true;
+    }
+    while (true) {
+      skip();
+      auto& m = members.emplace_back();
+      if (at_ >= input_.size() || input_[at_] != '"' || !string(m.first)) {
+        return false;
+      }
+      skip();
+      if (at_ >= input_.size() || input_[at_++] != ':' || !value(m.second)) {
+        return false;
+      }
+      skip();
+      if (at_ < input_.size() && input_[at_] == ',') {
+        at_++;
+      } else if (at_ < input_.size() && input_[at_] == '}') {
+        at_++;
+        out.data = std::move(members);
+        return true;
+      } else {
+        return false;
+      }
+    }
+  }
+
+  Input input_;
+  std::size_t at_ = 0;
+  std::size_t depth_ = 0;
+};
+
+std::string number(auto& rng, int digits) {
+  std::string s = std::to_string(rng() % 1000);
+  if (digits > 0) {
+    s.push_back('.');
+    for (int i = 0; i < digits; i++) {
+      s.push_back(static_cast<char>('0' + rng() % 10));
+    }
+  }
+  return s;
+}
+
+std::string text(auto& rng, std::size_t n) {
+  static constexpr Input words[] = { "the", "parser", "json", "tweet", "a", "combinator", "fast", "\\n", "\\u00e9t\\u00e9", "\\\"q\\\"" };
+  std::string s;
+  for (std::size_t i = 0; i < n; i++) {
+    s += words[rng() % std::size(words)];
+    s.push_back(' ');
+  }
+  return s;
+}
+
+// a list of statuses like the twitter dataset: strings, nested users and entities.
+struct twitter {
+  static constexpr std::string_view name = "twitter";
+  static void generate(std::string& out, auto& rng) {
+    out += out.empty() ? "[\n" : ",\n";
+    out += R"({"id": )" + std::to_string(rng() % 1000000000000) + R"(, "text": ")" + text(rng, 5 + rng() % 15) +
+           R"(", "truncated": false, "user": {"id": )" + std::to_string(rng() % 100000000) +
+           R"(, "name": "user )" + std::to_string(rng() % 1000) + R"(", "followers_count": )" + std::to_string(rng() % 100000) +
+           R"(, "verified": )" + (rng() % 2 ? "true" : "false") +
+           R"(, "url": null}, "entities": {"hashtags": [], "urls": [], "user_mentions": [{"id": )" +
+           std::to_string(rng() % 100000) + R"(, "indices": [)" + std::to_string(rng() % 100) + ", " +
+           std::to_string(rng() % 100) + R"(]}]}, "retweet_count": )" + std::to_string(rng() % 1000) + "}";
+  }
+};
+
+// events and performances like the citm_catalog dataset: mostly integers and small objects.
+struct citm {
+  static constexpr std::string_view name = "citm";
+  static void generate(std::string& out, auto& rng) {
+    out += out.empty() ? "[\n" : ",\n";
+    out += R"({"id": )" + std::to_string(138586341 + rng() % 1000) + R"(, "eventId": )" + std::to_string(rng() % 100000) +
+           R"(, "logo": null, "name": null, "prices": [)";
+    for (std::size_t i = 0, n = 1 + rng() % 4; i < n; i++) {
+      out += (i ? ", " : "") + std::string(R"({"amount": )") + std::to_string(rng() % 100000) +
+             R"(, "audienceSubCategoryId": 337100890, "seatCategoryId": )" + std::to_string(rng() % 1000000) + "}";
+    }
+    out += R"(], "seatCategories": [{"areas": [{"areaId": 205705999, "blockIds": []}], "seatCategoryId": 338937295}], "start": )" +
+           std::to_string(1372701600000 + rng() % 100000000) + R"(, "venueCode": "PLEYEL_PLEYEL"})";
+  }
+};
+
+// polygons of coordinates like the canada dataset: long arrays of floating point numbers.
+struct canada {
+  static constexpr std::string_view name = "canada";
+  static void generate(std::string& out, auto& rng) {
+    out += out.empty() ? "[\n" : ",\n";
+    out += "[";
+    for (int i = 0; i < 32; i++) {
+      out += (i ? "," : "") + std::string("[-") + number(rng, 15) + "," + number(rng, 14) + "]";
+    }
+    out += "]";
+  }
+};
+
+// a dataset of at least `size` bytes, a JSON array of its generated values.
+template <typename Dataset>
+const std::string& dataset(std::size_t size) {
+  static std::string input;
+  static std::size_t cached = 0;
+  if (cached != size) {
+    input = bench::generate(Dataset::name, size, [](std::string& out, auto& rng) { Dataset::generate(out, rng); }) + "\n]";
+    cached = size;
+  }
+  return input;
+}
+
+}  // namespace
+
+template <typename Dataset, bool Handwritten>
+static void json_parse(benchmark::State& state) {
+  const auto& input = dataset<Dataset>(state.range(0));
+
+  bench::report report(state);
+  for (auto _ : state) {
+    if constexpr (Handwritten) {
+      json::value value;
+      benchmark::DoNotOptimize(handwritten(input).parse(value));
+      benchmark::DoNotOptimize(value);
+    } else {
+      auto value = json::parse(input);
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  report.done(input.size());
+}
+
+BENCHMARK_TEMPLATE(json_parse, twitter, false)->Name("json_twitter")->Apply(bench::large_sizes);
+BENCHMARK_TEMPLATE(json_parse, twitter, true)->Name("json_twitter_handwritten")->Apply(bench::large_sizes);
+BENCHMARK_TEMPLATE(json_parse, citm, false)->Name("json_citm")->Apply(bench::large_sizes);
+BENCHMARK_TEMPLATE(json_parse, citm, true)->Name("json_citm_handwritten")->Apply(bench::large_sizes);
+BENCHMARK_TEMPLATE(json_parse, canada, false)->Name("json_canada")->Apply(bench::large_sizes);
+BENCHMARK_TEMPLATE(json_parse, canada, true)->Name("json_canada_handwritten")->Apply(bench::large_sizes);
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include <parserc/character.h>
+#include <parserc/memo.h>
+
+#include "bench.h"
+
+using namespace parsec;
+
+// expr := term '+' expr | term '-' expr | term
+// term := '(' expr ')' | digit
+// without memoization, each level of parentheses parses its term three times.
+template <bool Memo>
+struct grammar {
+  static ParserResult<char> expr(const Input& input) {
+    static constexpr auto parse = left(term, right(one_of<'+'>, expr)) || left(term, right(one_of<'-'>, expr)) || term;
+    return parse(input);
+  }
+
+  static ParserResult<char> term_body(const Input& input) {
+    static constexpr auto parse = between(one_of<'('>, expr, one_of<')'>) || digit;
+    return parse(input);
+  }
+
+  static constexpr auto term = [] {
+    if constexpr (Memo) {
+      return memo(term_body);
+    } else {
+      return term_body;
+    }
+  }();
+};
+
+// parentheses nested `depth` times around sums of digits.
+static std::string nested(std::size_t depth) {
+  std::string input = "1";
+  for (std::size_t i = 0; i < depth; i++) {
+    input = "(" + input + ")-2+3";
+  }
+  return input;
+}
+
+template <bool Memo>
+static void nested_parentheses(benchmark::State& state) {
+  const auto input = nested(state.range(0));
+
+  // one table for every parse, reset keeps its memory.
+  memo_table table(input);
+  bench::report report(state);
+  for (auto _ : state) {
+    if constexpr (Memo) {
+      table.reset(input);
+      auto result = grammar<true>::expr(input);
+      benchmark::DoNotOptimize(result);
+    } else {
+      auto result = grammar<false>::expr(input);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  report.done(input.size());
+}
+BENCHMARK_TEMPLATE(nested_parentheses, false)->Name("nested_parentheses")->DenseRange(4, 12, 4);
+BENCHMARK_TEMPLATE(nested_parentheses, true)->Name("nested_parentheses_memo")->DenseRange(4, 12, 4)->Arg(1000);
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <parserc/character.h>
+#include <parserc/combinator.h>
+
+#include "bench.h"
+
+using namespace parsec;
+
+// a result that counts how many times it is copied or moved.
+struct counted {
+  static inline std::size_t copies = 0;
+  static inline std::size_t moves = 0;
+
+  std::vector<char> value;
+
+  counted(std::vector<char> value) : value(std::move(value)) {}
+  counted(const counted& other) : value(other.value) { copies++; }
+  counted(counted&& other) noexcept : value(std::move(other.value)) { moves++; }
+  counted& operator=(const counted& other) {
+    copies++;
+    value = other.value;
+    return *this;
+  }
+  counted& operator=(counted&& other) noexcept {
+    moves++;
+    value = std::move(other.value);
+    return *this;
+  }
+};
+
+static constexpr auto word = many1(lower) | map([](auto&& chars) {
+  return counted{ std::forward<decltype(chars)>(chars) };
+});
+
+template <Parser P>
+static void copies(benchmark::State& state, P parse) {
+  const auto& input = bench::generate("words", state.range(0), [](std::string& out, auto& rng) {
+    if (!out.empty()) {
+      out.push_back(',');
+    }
+    out.append(1 + rng() % 12, static_cast<char>('a' + rng() % 26));
+  });
+
+  counted::copies = 0;
+  counted::moves = 0;
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+  state.counters["copies"] = benchmark::Counter(static_cast<double>(counted::copies),
+      benchmark::Counter::kAvgIterations);
+  state.counters["moves"] = benchmark::Counter(static_cast<double>(counted::moves),
+      benchmark::Counter::kAvgIterations);
+}
+
+static constexpr auto identity = map([](auto&& value) {
+  return std::forward<decltype(value)>(value);
+});
+
+BENCHMARK_CAPTURE(copies, map, word | identity | identity | identity)->Arg(bench::min_size);
+BENCHMARK_CAPTURE(copies, seq, word + right(comma, word) + right(comma, word))->Arg(bench::min_size);
+BENCHMARK_CAPTURE(copies, many, many(left(word, comma)))->Apply(bench::sizes);
+BENCHMARK_CAPTURE(copies, sepby, sepby(word, comma))->Apply(bench::sizes);
+BENCHMARK_CAPTURE(copies, nested, many(sepby1(word, comma) + many(comma)))->Apply(bench::sizes);
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include <parserc/character.h>
+#include <parserc/combinator.h>
+#include <parserc/optimize.h>
+#include <parserc/token.h>
+
+#include <array>
+#include <string>
+
+#include "bench.h"
+
+using namespace parsec;
+
+namespace {
+
+// the grammar of the error test, alternatives with a common prefix.
+constexpr auto ab = one_of<'a'> + one_of<'b'>;
+constexpr auto prefixed = ab + one_of<'c'> + one_of<'d'> || ab + one_of<'x'> + one_of<'y'>;
+
+// HTTP/1.1 request heads, validated and counted, written without care for speed.
+constexpr auto sp = skip(many(one_of<' '>));
+constexpr auto crlf = seq(skip(one_of<'\r'>), skip(one_of<'\n'>));
+
+template <fixed_string Name>
+constexpr auto header = seq(skip(lit<Name>), skip(one_of<':'>), sp, skip(many(none_of<'\r'>)), crlf);
+
+constexpr auto headers = header<"Host"> || header<"User-Agent"> || header<"Accept"> || header<"Accept-Encoding"> ||
+                         header<"Accept-Language"> || header<"Cache-Control"> || header<"Connection"> ||
+                         header<"Content-Length"> || header<"Content-Type"> || header<"Cookie">;
+
+constexpr auto version = seq(skip(lit<"HTTP/">), skip(digit), skip(one_of<'.'>), skip(digit));
+constexpr auto request_line = seq(keywords<"GET", "POST", "PUT", "PATCH", "DELETE", "HEAD">, skip(one_of<' '>),
+                                  skip(many(none_of<' '>)), skip(one_of<' '>), version, crlf);
+constexpr auto request = seq(request_line, skip(many(headers)), crlf);
+
+constexpr std::array<std::string_view, 6> methods = { "GET", "POST", "PUT", "PATCH", "DELETE", "HEAD" };
+constexpr std::array<std::string_view, 10> names = { "Host", "User-Agent", "Accept", "Accept-Encoding",
+                                                     "Accept-Language", "Cache-Control", "Connection",
+                                                     "Content-Length", "Content-Type", "Cookie" };
+
+const std::string& requests(std::size_t size) {
+  return bench::generate("requests", size, [](std::string& out, auto& rng) {
+    out += methods[rng() % methods.size()];
+    out += " /api/v1/items/" + std::to_string(rng() % 100000) + " HTTP/1.1\r\n";
+    for (std::size_t i = 0, n = 3 + rng() % 8; i < n; i++) {
+      out += names[rng() % names.size()];
+      out += ": value-" + std::to_string(rng() % 1000000) + "\r\n";
+    }
+    out += "\r\n";
+  });
+}
+
+}  // namespace
+
+template <bool Optimize>
+static void optimize_prefixed(benchmark::State& state) {
+  const auto& input = bench::generate("prefixed", state.range(0), [](std::string& out, auto& rng) {
+    out += rng() % 2 ? "abcd" : "abxy";
+  });
+  const auto parse = [] {
+    if constexpr (Optimize) {
+      return count(optimize(prefixed));
+    } else {
+      return count(prefixed);
+    }
+  }();
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size(), input.size() / 4);
+}
+BENCHMARK_TEMPLATE(optimize_prefixed, false)->Name("optimize_prefixed_off")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(optimize_prefixed, true)->Name("optimize_prefixed")->Apply(bench::sizes);
+
+template <bool Optimize>
+static void optimize_http(benchmark::State& state) {
+  const auto& input = requests(state.range(0));
+  const auto parse = [] {
+    if constexpr (Optimize) {
+      return count(optimize(request));
+    } else {
+      return count(request);
+    }
+  }();
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+BENCHMARK_TEMPLATE(optimize_http, false)->Name("optimize_http_off")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(optimize_http, true)->Name("optimize_http")->Apply(bench::sizes);
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include <parserc/file.h>
+#include <parserc/parallel.h>
+#include <parserc/token.h>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "bench.h"
+
+using namespace parsec;
+
+namespace {
+
+// a generated log of bench::max_size bytes in a temporary file, removed at exit.
+struct log_file {
+  std::filesystem::path path = std::filesystem::temp_directory_path() / "parsec_bench.log";
+  mapped_file file;
+
+  log_file() {
+    std::ofstream out(path, std::ios::binary);
+    std::string lines;
+    std::size_t size = 0;
+    auto& rng = bench::engine();
+    constexpr std::string_view levels[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+    while (size < static_cast<std::size_t>(bench::max_size)) {
+      lines.clear();
+      while (lines.size() < (1 << 20)) {
+        lines += "2024-05-01T12:" + std::to_string(10 + rng() % 50) + ":" + std::to_string(10 + rng() % 50) + " ";
+        lines += levels[rng() % 4];
+        lines += " worker-" + std::to_string(rng() % 64) + ": request " + std::to_string(rng() % 1000000) +
+                 " done in " + std::to_string(rng() % 1000) + " ms\n";
+      }
+      out << lines;
+      size += lines.size();
+    }
+    out.close();
+    file = std::move(mapped_file::open(path).value());
+  }
+
+  ~log_file() {
+    file = mapped_file();
+    std::filesystem::remove(path);
+  }
+};
+
+const log_file& log() {
+  static log_file log;
+  return log;
+}
+
+// the level of a line: timestamp level message.
+constexpr auto level = right(left(take_while(none_of<' '>), one_of<' '>),
+                             left(keywords<"DEBUG", "INFO", "WARN", "ERROR">,
+                                  left(take_while(none_of<'\n'>), one_of<'\n'>)));
+
+}  // namespace
+
+static void parallel_log(benchmark::State& state) {
+  const auto input = log().file.view();
+  thread_pool pool(state.range(0));
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse_parallel(level, input, '\n', pool);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+
+// from one thread up to every hardware thread.
+static void threads(benchmark::internal::Benchmark* b) {
+  int hardware = std::max(1u, std::thread::hardware_concurrency());
+  for (int threads = 1; threads < hardware; threads *= 2) {
+    b->Arg(threads);
+  }
+  b->Arg(hardware)->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+BENCHMARK(parallel_log)->Apply(threads);
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include <parserc/character.h>
+#include <parserc/combinator.h>
+#include <parserc/profile.h>
+
+#include <string>
+
+#include "bench.h"
+
+using namespace parsec;
+
+namespace {
+
+// records of key=value fields, with every rule named or none. The names only
+// record with -DPARSEC_BENCH_PROFILE=ON, which defines PARSEC_PROFILE.
+template <bool Named, fixed_string Name, typename P>
+constexpr auto rule(P parser) {
+  if constexpr (Named) {
+    return named<Name>(parser);
+  } else {
+    return parser;
+  }
+}
+
+template <bool Named>
+constexpr auto record() {
+  constexpr auto key = rule<Named, "key">(skip_many(lower));
+  constexpr auto value = rule<Named, "value">(skip_many(digit));
+  constexpr auto field = rule<Named, "field">(seq(key, skip(one_of<'='>), value));
+  return rule<Named, "record">(left(count(left(field, one_of<';'>)), one_of<'\n'>));
+}
+
+const std::string& records(std::size_t size) {
+  return bench::generate("records", size, [](std::string& out, auto& rng) {
+    for (std::size_t i = 0, n = 1 + rng() % 8; i < n; i++) {
+      out += std::string(1 + rng() % 8, static_cast<char>('a' + rng() % 26)) + '=' + std::to_string(rng() % 100000) + ';';
+    }
+    out += '\n';
+  });
+}
+
+}  // namespace
+
+// the cost of named rules: 0 plain, 1 named without a profiler, 2 profiled.
+template <int Mode>
+static void profile_records(benchmark::State& state) {
+  const auto& input = records(state.range(0));
+  constexpr auto parse = count(record<Mode != 0>());
+
+  bench::report report(state);
+  for (auto _ : state) {
+    if constexpr (Mode == 2) {
+      profiler profile;
+      auto result = parse(input);
+      benchmark::DoNotOptimize(result);
+    } else {
+      auto result = parse(input);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  report.done(input.size());
+}
+BENCHMARK_TEMPLATE(profile_records, 0)->Name("profile_records_plain")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(profile_records, 1)->Name("profile_records_named")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(profile_records, 2)->Name("profile_records_profiled")->Apply(bench::sizes);
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include <parserc/character.h>
+#include <parserc/combinator.h>
+#include <parserc/regular.h>
+#include <parserc/token.h>
+
+#include <string>
+
+#include "bench.h"
+
+using namespace parsec;
+
+namespace {
+
+constexpr auto octet = digit + many(digit);
+constexpr auto ipv4 = seq(octet, skip(dot), octet, skip(dot), octet, skip(dot), octet);
+
+// ISO-8601 timestamps of logs, with an optional fraction and a zone.
+constexpr auto d2 = digit + digit;
+constexpr auto date = seq(d2, d2, skip(one_of<'-'>), d2, skip(one_of<'-'>), d2);
+constexpr auto time = seq(d2, skip(one_of<':'>), d2, skip(one_of<':'>), d2);
+constexpr auto fraction = slice(one_of<'.'> + digit + many(digit)) || slice(lit<"">);
+constexpr auto zone = slice(one_of<'Z'>) || slice(seq(one_of<'+', '-'>, d2, skip(one_of<':'>), d2));
+constexpr auto timestamp = seq(slice(date), skip(one_of<'T'>), slice(time), fraction, zone);
+
+const std::string& addresses(std::size_t size) {
+  return bench::generate("addresses", size, [](std::string& out, auto& rng) {
+    for (int i = 0; i < 4; i++) {
+      out += std::to_string(rng() % 256);
+      out += i == 3 ? '\n' : '.';
+    }
+  });
+}
+
+std::string digits(std::size_t value, std::size_t width) {
+  auto ret = std::to_string(value);
+  return std::string(width - ret.size(), '0') + ret;
+}
+
+const std::string& timestamps(std::size_t size) {
+  return bench::generate("timestamps", size, [](std::string& out, auto& rng) {
+    out += digits(1970 + rng() % 100, 4) + '-' + digits(1 + rng() % 12, 2) + '-' + digits(1 + rng() % 28, 2);
+    out += 'T' + digits(rng() % 24, 2) + ':' + digits(rng() % 60, 2) + ':' + digits(rng() % 60, 2);
+    if (rng() % 2) {
+      out += '.' + digits(rng() % 1000000, 6);
+    }
+    if (rng() % 2) {
+      out += 'Z';
+    } else {
+      out += (rng() % 2 ? '+' : '-') + digits(rng() % 15, 2) + ':' + digits(rng() % 4 * 15, 2);
+    }
+    out += '\n';
+  });
+}
+
+}  // namespace
+
+template <bool Regular>
+static void regular_ipv4(benchmark::State& state) {
+  const auto& input = addresses(state.range(0));
+  const auto parse = [] {
+    if constexpr (Regular) {
+      return count(left(regular(ipv4), one_of<'\n'>));
+    } else {
+      return count(left(slice(ipv4), one_of<'\n'>));
+    }
+  }();
+
+  bench::report report(state);
+  std::size_t parses = 0;
+  for (auto _ : state) {
+    auto result = parse(input);
+    parses = std::get<0>(result.value());
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size(), parses);
+}
+BENCHMARK_TEMPLATE(regular_ipv4, false)->Name("regular_ipv4_combinator")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(regular_ipv4, true)->Name("regular_ipv4")->Apply(bench::sizes);
+
+template <bool Regular>
+static void regular_timestamps(benchmark::State& state) {
+  const auto& input = timestamps(state.range(0));
+  const auto parse = [] {
+    if constexpr (Regular) {
+      return count(left(regular(timestamp), one_of<'\n'>));
+    } else {
+      return count(left(slice(timestamp), one_of<'\n'>));
+    }
+  }();
+
+  bench::report report(state);
+  std::size_t parses = 0;
+  for (auto _ : state) {
+    auto result = parse(input);
+    parses = std::get<0>(result.value());
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size(), parses);
+}
+BENCHMARK_TEMPLATE(regular_timestamps, false)->Name("regular_timestamps_combinator")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(regular_timestamps, true)->Name("regular_timestamps")->Apply(bench::sizes);
\ No newline at end of file
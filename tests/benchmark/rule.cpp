@@ -0,0 +1,62 @@
+#include <parserc/character.h>
+#include <parserc/combinator.h>
+#include <parserc/rule.h>
+
+#include "bench.h"
+
+using namespace parsec;
+
+// a digit through a rule, the overhead of a rule on every call.
+template <bool Rule>
+static void rule_digits(benchmark::State& state) {
+  const auto& input = bench::chars("0123456789", state.range(0));
+
+  rule<char> digits;
+  digits = digit;
+  const auto parse = [&] {
+    if constexpr (Rule) {
+      return many(digits);
+    } else {
+      return many(digit);
+    }
+  }();
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = parse(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size(), input.size());
+}
+BENCHMARK_TEMPLATE(rule_digits, false)->Name("rule_digits_inline")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(rule_digits, true)->Name("rule_digits")->Apply(bench::sizes);
+
+// nesting := '(' nesting ')' | digit, through a rule or a recursive function.
+static ParserResult<char> nesting_function(const Input& input) {
+  static constexpr auto parse = between(one_of<'('>, nesting_function, one_of<')'>) || digit;
+  return parse(input);
+}
+
+template <bool Rule>
+static void rule_nesting(benchmark::State& state) {
+  const auto depth = static_cast<std::size_t>(state.range(0));
+  const auto input = std::string(depth, '(') + "1" + std::string(depth, ')');
+
+  rule<char> nesting(depth + 1);
+  const auto definition = between(one_of<'('>, nesting, one_of<')'>) || digit;
+  nesting = definition;
+
+  bench::report report(state);
+  for (auto _ : state) {
+    if constexpr (Rule) {
+      auto result = nesting(input);
+      benchmark::DoNotOptimize(result);
+    } else {
+      auto result = nesting_function(input);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  report.done(input.size());
+}
+BENCHMARK_TEMPLATE(rule_nesting, false)->Name("rule_nesting_function")->RangeMultiplier(10)->Range(10, 10000);
+BENCHMARK_TEMPLATE(rule_nesting, true)->Name("rule_nesting")->RangeMultiplier(10)->Range(10, 10000);
\ No newline at end of file
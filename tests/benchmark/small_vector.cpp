@@ -0,0 +1,69 @@
+#include <parserc/character.h>
+#include <parserc/combinator.h>
+#include <parserc/small_vector.h>
+#include <parserc/token.h>
+
+#include <vector>
+
+#include "bench.h"
+
+using namespace parsec;
+
+// path := ('/' segment)* '\n', of 1 to 6 segments.
+template <typename List>
+static void path_segments(benchmark::State& state) {
+  constexpr auto segment = right(one_of<'/'>, take_while(none_of<'/', '\n'>));
+  constexpr auto path = left(many<List>(segment), one_of<'\n'>);
+  const auto& input = bench::generate("paths", state.range(0), [](std::string& out, auto& rng) {
+    for (std::size_t i = 0, n = 1 + rng() % 6; i < n; i++) {
+      out.push_back('/');
+      out.append(1 + rng() % 8, static_cast<char>('a' + rng() % 26));
+    }
+    out.push_back('\n');
+  });
+
+  std::size_t parses = 0;
+  bench::report report(state);
+  for (auto _ : state) {
+    parses = 0;
+    Input rest = input;
+    while (auto result = path(rest)) {
+      benchmark::DoNotOptimize(result);
+      rest = std::get<1>(*result);
+      parses++;
+    }
+  }
+  report.done(input.size(), parses);
+}
+BENCHMARK_TEMPLATE(path_segments, std::vector<Input>)->Name("path_segments")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(path_segments, small_vector<Input, 8>)->Name("path_segments_small_vector")->Apply(bench::sizes);
+
+// list := number (',' number)* '\n', of 0 to 8 numbers.
+template <typename List>
+static void short_lists(benchmark::State& state) {
+  constexpr auto list = left(sepby<List>(decimal<int>, comma), one_of<'\n'>);
+  const auto& input = bench::generate("short lists", state.range(0), [](std::string& out, auto& rng) {
+    for (std::size_t i = 0, n = rng() % 9; i < n; i++) {
+      if (i != 0) {
+        out.push_back(',');
+      }
+      out.append(std::to_string(rng() % 10000));
+    }
+    out.push_back('\n');
+  });
+
+  std::size_t parses = 0;
+  bench::report report(state);
+  for (auto _ : state) {
+    parses = 0;
+    Input rest = input;
+    while (auto result = list(rest)) {
+      benchmark::DoNotOptimize(result);
+      rest = std::get<1>(*result);
+      parses++;
+    }
+  }
+  report.done(input.size(), parses);
+}
+BENCHMARK_TEMPLATE(short_lists, std::vector<int>)->Name("short_lists")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(short_lists, small_vector<int, 8>)->Name("short_lists_small_vector")->Apply(bench::sizes);
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include <parserc/token.h>
+
+#include <algorithm>
+#include <charconv>
+#include <array>
+#include <cmath>
+
+#include "bench.h"
+
+using namespace parsec;
+
+// numbers in the given base separated by spaces.
+static const std::string& numbers(std::size_t size, int base) {
+  return bench::generate("numbers" + std::to_string(base), size, [base](std::string& out, auto& rng) {
+    char text[24];
+    auto end = std::to_chars(text, text + sizeof(text), rng() >> (rng() % 64), base).ptr;
+    out.append(text, end);
+    out.push_back(' ');
+  });
+}
+
+template <Parser P>
+static void integers(benchmark::State& state, P parse, int base) {
+  const auto& input = numbers(state.range(0), base);
+
+  std::size_t parses = 0;
+  bench::report report(state);
+  for (auto _ : state) {
+    parses = 0;
+    Input rest = input;
+    while (auto result = parse(rest)) {
+      benchmark::DoNotOptimize(std::get<0>(result.value()));
+      rest = std::get<1>(result.value()).substr(1);
+      parses++;
+    }
+  }
+  report.done(input.size(), parses);
+}
+
+template <typename T, int Base>
+static void from_chars(benchmark::State& state) {
+  const auto& input = numbers(state.range(0), Base);
+
+  std::size_t parses = 0;
+  bench::report report(state);
+  for (auto _ : state) {
+    parses = 0;
+    const char* first = input.data();
+    const char* last = input.data() + input.size();
+    while (first != last) {
+      T value;
+      auto [ptr, ec] = std::from_chars(first, last, value, Base);
+      if (ec != std::errc{}) {
+        break;
+      }
+      benchmark::DoNotOptimize(value);
+      first = ptr + 1;
+      parses++;
+    }
+  }
+  report.done(input.size(), parses);
+}
+
+BENCHMARK_CAPTURE(integers, decimal<uint64_t>, decimal<std::uint64_t>, 10)->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(from_chars, std::uint64_t, 10)->Name("from_chars/decimal")->Apply(bench::sizes);
+BENCHMARK_CAPTURE(integers, hexadecimal<uint64_t>, hexadecimal<std::uint64_t>, 16)->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(from_chars, std::uint64_t, 16)->Name("from_chars/hexadecimal")->Apply(bench::sizes);
+BENCHMARK_CAPTURE(integers, octal<uint64_t>, octal<std::uint64_t>, 8)->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(from_chars, std::uint64_t, 8)->Name("from_chars/octal")->Apply(bench::sizes);
+
+// floating point numbers with up to 17 significant digits and an exponent.
+static const std::string& floats(std::size_t size) {
+  return bench::generate("floats", size, [](std::string& out, auto& rng) {
+    std::uniform_real_distribution<double> mantissa(-1, 1);
+    std::uniform_int_distribution<int> exponent(-300, 300);
+    char text[32];
+    auto end = std::to_chars(text, text + sizeof(text), mantissa(rng) * std::pow(10.0, exponent(rng))).ptr;
+    out.append(text, end);
+    out.push_back(' ');
+  });
+}
+
+static void floating_double(benchmark::State& state) {
+  const auto& input = floats(state.range(0));
+
+  std::size_t parses = 0;
+  bench::report report(state);
+  for (auto _ : state) {
+    parses = 0;
+    Input rest = input;
+    while (auto result = floating<double>(rest)) {
+      benchmark::DoNotOptimize(std::get<0>(result.value()));
+      rest = std::get<1>(result.value()).substr(1);
+      parses++;
+    }
+  }
+  report.done(input.size(), parses);
+}
+
+static void from_chars_double(benchmark::State& state) {
+  const auto& input = floats(state.range(0));
+
+  std::size_t parses = 0;
+  bench::report report(state);
+  for (auto _ : state) {
+    parses = 0;
+    const char* first = input.data();
+    const char* last = input.data() + input.size();
+    while (first != last) {
+      double value;
+      auto [ptr, ec] = std::from_chars(first, last, value);
+      if (ec != std::errc{}) {
+        break;
+      }
+      benchmark::DoNotOptimize(value);
+      first = ptr + 1;
+      parses++;
+    }
+  }
+  report.done(input.size(), parses);
+}
+
+// a 100 MB file of numbers, or the largest size allowed.
+BENCHMARK(floating_double)->Apply(bench::sizes)->Arg(std::min<std::int64_t>(100 << 20, bench::max_size));
+BENCHMARK(from_chars_double)->Apply(bench::sizes)->Arg(std::min<std::int64_t>(100 << 20, bench::max_size));
+
+// words drawn from a list, each followed by a space, matched by a chain of
+// symbols or by one keywords parser.
+template <fixed_string... Words>
+struct wordlist {
+  static constexpr std::array<std::string_view, sizeof...(Words)> words{ Words... };
+  static constexpr auto chain = skip_many((... || left(symbol(Words), space)));
+  static constexpr auto trie = skip_many(left(keywords<Words...>, space));
+
+  static const std::string& generate(std::size_t size) {
+    return bench::generate(words[0], size, [](std::string& out, auto& rng) {
+      out.append(words[rng() % words.size()]);
+      out.push_back(' ');
+    });
+  }
+};
+
+template <typename Words, bool Trie>
+static void parse_words(benchmark::State& state) {
+  const auto& input = Words::generate(state.range(0));
+
+  bench::report report(state);
+  for (auto _ : state) {
+    auto result = Trie ? Words::trie(input) : Words::chain(input);
+    benchmark::DoNotOptimize(result);
+  }
+  report.done(input.size());
+}
+
+using methods = wordlist<"GET", "PUT", "POST", "HEAD", "PATCH", "DELETE", "OPTIONS">;
+
+using cpp_keywords = wordlist<
+    "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case",
+    "catch", "char", "char8_t", "char16_t", "char32_t", "class", "compl", "concept", "const",
+    "consteval", "constexpr", "constinit", "const_cast", "continue", "co_await", "co_return",
+    "co_yield", "decltype", "default", "delete", "do", "double", "dynamic_cast", "else", "enum",
+    "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int",
+    "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or",
+    "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "requires", "return",
+    "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch",
+    "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename",
+    "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq">;
+
+BENCHMARK_TEMPLATE(parse_words, methods, false)->Name("symbol_methods")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(parse_words, methods, true)->Name("keywords_methods")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(parse_words, cpp_keywords, false)->Name("symbol_cpp_keywords")->Apply(bench::sizes);
+BENCHMARK_TEMPLATE(parse_words, cpp_keywords, true)->Name("keywords_cpp_keywords")->Apply(bench::sizes);
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include <doctest/doctest.h>
+#include <parserc/arena.h>
+#include <parserc/token.h>
+
+#include <string>
+
+using namespace parsec;
+
+TEST_CASE("arena") {
+  arena a(256);
+  std::pmr::polymorphic_allocator<int> alloc(&a);
+
+  auto* p = alloc.allocate(10);
+  auto* q = alloc.allocate(10);
+  CHECK(q >= p + 10);
+  CHECK(reinterpret_cast<std::uintptr_t>(alloc.allocate(1)) % alignof(int) == 0);
+
+  // larger than a block.
+  auto* big = alloc.allocate(1000);
+  big[999] = 1;
+  auto capacity = a.capacity();
+  CHECK(capacity >= 256 + 4000);
+
+  // reset reuses the blocks.
+  a.reset();
+  CHECK(alloc.allocate(10) == p);
+  CHECK(alloc.allocate(1000) != nullptr);
+  CHECK(a.capacity() == capacity);
+
+  CHECK(arena_resource() == &a);
+  {
+    arena inner;
+    CHECK(arena_resource() == &inner);
+  }
+  CHECK(arena_resource() == &a);
+}
+
+TEST_CASE("pmr") {
+  constexpr auto number = decimal<int>;
+  constexpr auto comma = one_of<','>;
+  const std::pmr::vector<int> list{ 1, 22, 333 };
+
+  CHECK(arena_resource() == std::pmr::get_default_resource());
+  CHECK(pmr::many(left(number, comma))("1,22,333,") == std::make_tuple(list, ""));
+
+  arena a;
+  auto many = pmr::many(left(number, comma))("1,22,333,x");
+  REQUIRE(many.has_value());
+  CHECK(std::get<0>(*many) == list);
+  CHECK(std::get<0>(*many).get_allocator().resource() == &a);
+
+  CHECK(pmr::many1(number)("x").has_value() == false);
+  CHECK(pmr::sepby1(number, comma)("1,22,333") == std::make_tuple(list, ""));
+  CHECK(pmr::sepby1(number, comma)("").has_value() == false);
+  CHECK(pmr::sepby(number, comma)("1,22,333") == std::make_tuple(list, ""));
+
+  auto empty = pmr::sepby(number, comma)("x");
+  REQUIRE(empty.has_value());
+  CHECK(std::get<0>(*empty).empty());
+  CHECK(std::get<0>(*empty).get_allocator().resource() == &a);
+  CHECK(std::get<1>(*empty) == "x");
+
+  // first sets are kept.
+  static_assert(first_v<decltype(pmr::many1(number))> == first_v<decltype(number)>);
+  static_assert(nullable_v<decltype(pmr::sepby1(number, comma))> == false);
+}
\ No newline at end of file
@@ -1,126 +1,187 @@
-#include <doctest/doctest.h>
-#include <parserc/character.h>
-
-using namespace parsec;
-
-TEST_CASE("range") {
-  CHECK(range<'a', 'd'>("e").has_value() == false);
-  CHECK(range<'a', 'd'>("a") == std::make_tuple('a', ""));
-  CHECK(range<'a', 'd'>("b") == std::make_tuple('b', ""));
-  CHECK(range<'a', 'd'>("c") == std::make_tuple('c', ""));
-  CHECK(range<'a', 'd'>("d") == std::make_tuple('d', ""));
-
-  static_assert(range<'a', 'd'>("e").has_value() == false);
-  static_assert(range<'a', 'd'>("a") == std::make_tuple('a', ""));
-  static_assert(range<'a', 'd'>("b") == std::make_tuple('b', ""));
-  static_assert(range<'a', 'd'>("c") == std::make_tuple('c', ""));
-  static_assert(range<'a', 'd'>("d") == std::make_tuple('d', ""));
-}
-
-TEST_CASE("one_of") {
-  CHECK(one_of<'a'>("").has_value() == false);
-  CHECK(one_of<'a'>("b").has_value() == false);
-  CHECK(one_of<'a'>("a") == std::make_tuple('a', ""));
-  CHECK(one_of<'a'>("ab") == std::make_tuple('a', "b"));
-
-  CHECK(one_of<'a', 'b', 'c'>("").has_value() == false);
-  CHECK(one_of<'a', 'b', 'c'>("d").has_value() == false);
-  CHECK(one_of<'a', 'b', 'c'>("a") == std::make_tuple('a', ""));
-  CHECK(one_of<'a', 'b', 'c'>("b") == std::make_tuple('b', ""));
-  CHECK(one_of<'a', 'b', 'c'>("c") == std::make_tuple('c', ""));
-  CHECK(one_of<'a', 'b', 'c'>("ab") == std::make_tuple('a', "b"));
-
-  static_assert(one_of<'a'>("").has_value() == false);
-  static_assert(one_of<'a'>("b").has_value() == false);
-  static_assert(one_of<'a'>("a") == std::make_tuple('a', ""));
-  static_assert(one_of<'a'>("ab") == std::make_tuple('a', "b"));
-
-  static_assert(one_of<'a', 'b', 'c'>("").has_value() == false);
-  static_assert(one_of<'a', 'b', 'c'>("d").has_value() == false);
-  static_assert(one_of<'a', 'b', 'c'>("a") == std::make_tuple('a', ""));
-  static_assert(one_of<'a', 'b', 'c'>("b") == std::make_tuple('b', ""));
-  static_assert(one_of<'a', 'b', 'c'>("c") == std::make_tuple('c', ""));
-  static_assert(one_of<'a', 'b', 'c'>("ab") == std::make_tuple('a', "b"));
-}
-
-TEST_CASE("none_of") {
-  CHECK(none_of<'a'>("").has_value() == false);
-  CHECK(none_of<'a'>("a").has_value() == false);
-  CHECK(none_of<'a'>("b") == std::make_tuple('b', ""));
-  CHECK(none_of<'a'>("ca") == std::make_tuple('c', "a"));
-
-  CHECK(none_of<'a', 'b', 'c'>("").has_value() == false);
-  CHECK(none_of<'a', 'b', 'c'>("a").has_value() == false);
-  CHECK(none_of<'a', 'b', 'c'>("b").has_value() == false);
-  CHECK(none_of<'a', 'b', 'c'>("c").has_value() == false);
-  CHECK(none_of<'a', 'b', 'c'>("d") == std::make_tuple('d', ""));
-  CHECK(none_of<'a', 'b', 'c'>("ef") == std::make_tuple('e', "f"));
-
-  static_assert(none_of<'a'>("").has_value() == false);
-  static_assert(none_of<'a'>("a").has_value() == false);
-  static_assert(none_of<'a'>("b") == std::make_tuple('b', ""));
-  static_assert(none_of<'a'>("ca") == std::make_tuple('c', "a"));
-
-  static_assert(none_of<'a', 'b', 'c'>("").has_value() == false);
-  static_assert(none_of<'a', 'b', 'c'>("a").has_value() == false);
-  static_assert(none_of<'a', 'b', 'c'>("b").has_value() == false);
-  static_assert(none_of<'a', 'b', 'c'>("c").has_value() == false);
-  static_assert(none_of<'a', 'b', 'c'>("d") == std::make_tuple('d', ""));
-  static_assert(none_of<'a', 'b', 'c'>("ef") == std::make_tuple('e', "f"));
-}
-
-TEST_CASE("character") {
-  CHECK(digit("a").has_value() == false);
-  CHECK(digit("1") == std::make_tuple('1', ""));
-  CHECK(octdigit("8").has_value() == false);
-  CHECK(octdigit("1") == std::make_tuple('1', ""));
-  CHECK(hexdigit("x").has_value() == false);
-  CHECK(hexdigit("1") == std::make_tuple('1', ""));
-  CHECK(hexdigit("a") == std::make_tuple('a', ""));
-  CHECK(lower("A").has_value() == false);
-  CHECK(lower("a") == std::make_tuple('a', ""));
-  CHECK(upper("a").has_value() == false);
-  CHECK(upper("A") == std::make_tuple('A', ""));
-  CHECK(alpha("0").has_value() == false);
-  CHECK(alpha("a") == std::make_tuple('a', ""));
-  CHECK(alpha("A") == std::make_tuple('A', ""));
-  CHECK(alphanum("1") == std::make_tuple('1', ""));
-  CHECK(alphanum("a") == std::make_tuple('a', ""));
-  CHECK(alphanum("A") == std::make_tuple('A', ""));
-  CHECK(sign("-") == std::make_tuple('-', ""));
-  CHECK(sign("+") == std::make_tuple('+', ""));
-  CHECK(space(" ") == std::make_tuple(' ', ""));
-  CHECK(space("\n") == std::make_tuple('\n', ""));
-  CHECK(dot(".") == std::make_tuple('.', ""));
-  CHECK(semi(";") == std::make_tuple(';', ""));
-  CHECK(comma(",") == std::make_tuple(',', ""));
-  CHECK(colon(":") == std::make_tuple(':', ""));
-  CHECK(quota("\"") == std::make_tuple('"', ""));
-
-  static_assert(digit("a").has_value() == false);
-  static_assert(digit("1") == std::make_tuple('1', ""));
-  static_assert(octdigit("8").has_value() == false);
-  static_assert(octdigit("1") == std::make_tuple('1', ""));
-  static_assert(hexdigit("x").has_value() == false);
-  static_assert(hexdigit("1") == std::make_tuple('1', ""));
-  static_assert(hexdigit("a") == std::make_tuple('a', ""));
-  static_assert(lower("A").has_value() == false);
-  static_assert(lower("a") == std::make_tuple('a', ""));
-  static_assert(upper("a").has_value() == false);
-  static_assert(upper("A") == std::make_tuple('A', ""));
-  static_assert(alpha("0").has_value() == false);
-  static_assert(alpha("a") == std::make_tuple('a', ""));
-  static_assert(alpha("A") == std::make_tuple('A', ""));
-  static_assert(alphanum("1") == std::make_tuple('1', ""));
-  static_assert(alphanum("a") == std::make_tuple('a', ""));
-  static_assert(alphanum("A") == std::make_tuple('A', ""));
-  static_assert(sign("-") == std::make_tuple('-', ""));
-  static_assert(sign("+") == std::make_tuple('+', ""));
-  static_assert(space(" ") == std::make_tuple(' ', ""));
-  static_assert(space("\n") == std::make_tuple('\n', ""));
-  static_assert(dot(".") == std::make_tuple('.', ""));
-  static_assert(semi(";") == std::make_tuple(';', ""));
-  static_assert(comma(",") == std::make_tuple(',', ""));
-  static_assert(colon(":") == std::make_tuple(':', ""));
-  static_assert(quota("\"") == std::make_tuple('"', ""));
+#include <doctest/doctest.h>
+#include <parserc/character.h>
+
+#include <string>
+
+using namespace parsec;
+
+TEST_CASE("range") {
+  CHECK(range<'a', 'd'>("e").has_value() == false);
+  CHECK(range<'a', 'd'>("a") == std::make_tuple('a', ""));
+  CHECK(range<'a', 'd'>("b") == std::make_tuple('b', ""));
+  CHECK(range<'a', 'd'>("c") == std::make_tuple('c', ""));
+  CHECK(range<'a', 'd'>("d") == std::make_tuple('d', ""));
+
+  static_assert(range<'a', 'd'>("e").has_value() == false);
+  static_assert(range<'a', 'd'>("a") == std::make_tuple('a', ""));
+  static_assert(range<'a', 'd'>("b") == std::make_tuple('b', ""));
+  static_assert(range<'a', 'd'>("c") == std::make_tuple('c', ""));
+  static_assert(range<'a', 'd'>("d") == std::make_tuple('d', ""));
+}
+
+TEST_CASE("one_of") {
+  CHECK(one_of<'a'>("").has_value() == false);
+  CHECK(one_of<'a'>("b").has_value() == false);
+  CHECK(one_of<'a'>("a") == std::make_tuple('a', ""));
+  CHECK(one_of<'a'>("ab") == std::make_tuple('a', "b"));
+
+  CHECK(one_of<'a', 'b', 'c'>("").has_value() == false);
+  CHECK(one_of<'a', 'b', 'c'>("d").has_value() == false);
+  CHECK(one_of<'a', 'b', 'c'>("a") == std::make_tuple('a', ""));
+  CHECK(one_of<'a', 'b', 'c'>("b") == std::make_tuple('b', ""));
+  CHECK(one_of<'a', 'b', 'c'>("c") == std::make_tuple('c', ""));
+  CHECK(one_of<'a', 'b', 'c'>("ab") == std::make_tuple('a', "b"));
+
+  static_assert(one_of<'a'>("").has_value() == false);
+  static_assert(one_of<'a'>("b").has_value() == false);
+  static_assert(one_of<'a'>("a") == std::make_tuple('a', ""));
+  static_assert(one_of<'a'>("ab") == std::make_tuple('a', "b"));
+
+  static_assert(one_of<'a', 'b', 'c'>("").has_value() == false);
+  static_assert(one_of<'a', 'b', 'c'>("d").has_value() == false);
+  static_assert(one_of<'a', 'b', 'c'>("a") == std::make_tuple('a', ""));
+  static_assert(one_of<'a', 'b', 'c'>("b") == std::make_tuple('b', ""));
+  static_assert(one_of<'a', 'b', 'c'>("c") == std::make_tuple('c', ""));
+  static_assert(one_of<'a', 'b', 'c'>("ab") == std::make_tuple('a', "b"));
+}
+
+TEST_CASE("none_of") {
+  CHECK(none_of<'a'>("").has_value() == false);
+  CHECK(none_of<'a'>("a").has_value() == false);
+  CHECK(none_of<'a'>("b") == std::make_tuple('b', ""));
+  CHECK(none_of<'a'>("ca") == std::make_tuple('c', "a"));
+
+  CHECK(none_of<'a', 'b', 'c'>("").has_value() == false);
+  CHECK(none_of<'a', 'b', 'c'>("a").has_value() == false);
+  CHECK(none_of<'a', 'b', 'c'>("b").has_value() == false);
+  CHECK(none_of<'a', 'b', 'c'>("c").has_value() == false);
+  CHECK(none_of<'a', 'b', 'c'>("d") == std::make_tuple('d', ""));
+  CHECK(none_of<'a', 'b', 'c'>("ef") == std::make_tuple('e', "f"));
+
+  static_assert(none_of<'a'>("").has_value() == false);
+  static_assert(none_of<'a'>("a").has_value() == false);
+  static_assert(none_of<'a'>("b") == std::make_tuple('b', ""));
+  static_assert(none_of<'a'>("ca") == std::make_tuple('c', "a"));
+
+  static_assert(none_of<'a', 'b', 'c'>("").has_value() == false);
+  static_assert(none_of<'a', 'b', 'c'>("a").has_value() == false);
+  static_assert(none_of<'a', 'b', 'c'>("b").has_value() == false);
+  static_assert(none_of<'a', 'b', 'c'>("c").has_value() == false);
+  static_assert(none_of<'a', 'b', 'c'>("d") == std::make_tuple('d', ""));
+  static_assert(none_of<'a', 'b', 'c'>("ef") == std::make_tuple('e', "f"));
+}
+
+TEST_CASE("charset") {
+  constexpr auto ident = one_of<'_'> || alphanum;
+
+  static_assert(std::same_as<decltype(hexdigit), const charset<charmap::range('0', '9') | charmap::range('A', 'F') | charmap::range('a', 'f')>>);
+  static_assert(std::same_as<decltype(ident), const charset<charmap::of('_') | alphanum.map>>);
+  static_assert(none_of<'a'>.map == ~one_of<'a'>.map);
+
+  CHECK(ident("_") == std::make_tuple('_', ""));
+  CHECK(ident("z") == std::make_tuple('z', ""));
+  CHECK(ident("-").has_value() == false);
+  CHECK(none_of<'a'>("\xff") == std::make_tuple('\xff', ""));
+  CHECK(one_of<'\xff'>("\xff") == std::make_tuple('\xff', ""));
+
+  static_assert(ident("_") == std::make_tuple('_', ""));
+  static_assert(ident("z") == std::make_tuple('z', ""));
+  static_assert(ident("-").has_value() == false);
+  static_assert(none_of<'a'>("\xff") == std::make_tuple('\xff', ""));
+  static_assert(one_of<'\xff'>("\xff") == std::make_tuple('\xff', ""));
+}
+
+TEST_CASE("take_while") {
+  constexpr auto is_a = [](char c) {
+    return c == 'a';
+  };
+
+  CHECK(take_while(is_a)("") == std::make_tuple("", ""));
+  CHECK(take_while(is_a)("b") == std::make_tuple("", "b"));
+  CHECK(take_while(is_a)("aab") == std::make_tuple("aa", "b"));
+  CHECK(take_while1(is_a)("b").has_value() == false);
+  CHECK(take_while1(is_a)("aab") == std::make_tuple("aa", "b"));
+
+  static_assert(take_while(is_a)("") == std::make_tuple("", ""));
+  static_assert(take_while(is_a)("b") == std::make_tuple("", "b"));
+  static_assert(take_while(is_a)("aab") == std::make_tuple("aa", "b"));
+  static_assert(take_while1(is_a)("b").has_value() == false);
+  static_assert(take_while1(is_a)("aab") == std::make_tuple("aa", "b"));
+}
+
+TEST_CASE("scan") {
+  for (std::size_t n = 0; n < 100; n++) {
+    auto run = std::string(n, 'a') + "-a";
+    CHECK(scan<alphanum.map>(run) == n);
+    CHECK(scan<none_of<'-'>.map>(run) == n);
+    CHECK(scan<space.map>(run) == 0);
+    CHECK(take_while(alphanum)(run) == std::make_tuple(std::string_view(run).substr(0, n), std::string_view(run).substr(n)));
+    CHECK(count(alphanum)(run) == std::make_tuple(n, std::string_view(run).substr(n)));
+  }
+
+  auto bytes = std::string(40, '\x80') + "\x7f";
+  CHECK(scan<none_of<'\x7f'>.map>(bytes) == 40);
+  CHECK(scan<range<'\x80', '\xff'>.map>(bytes) == 40);
+  auto digits = std::string(40, '7') + "a";
+  CHECK(many1(digit)(digits) == std::make_tuple(std::vector<char>(40, '7'), "a"));
+
+  static_assert(scan<alphanum.map>("abc-") == 3);
+  static_assert(take_while(alphanum)("abc-") == std::make_tuple("abc", "-"));
+  static_assert(many1(alphanum)("-").has_value() == false);
+}
+
+TEST_CASE("character") {
+  CHECK(digit("a").has_value() == false);
+  CHECK(digit("1") == std::make_tuple('1', ""));
+  CHECK(octdigit("8").has_value() == false);
+  CHECK(octdigit("1") == std::make_tuple('1', ""));
+  CHECK(hexdigit("x").has_value() == false);
+  CHECK(hexdigit("1") == std::make_tuple('1', ""));
+  CHECK(hexdigit("a") == std::make_tuple('a', ""));
+  CHECK(lower("A").has_value() == false);
+  CHECK(lower("a") == std::make_tuple('a', ""));
+  CHECK(upper("a").has_value() == false);
+  CHECK(upper("A") == std::make_tuple('A', ""));
+  CHECK(alpha("0").has_value() == false);
+  CHECK(alpha("a") == std::make_tuple('a', ""));
+  CHECK(alpha("A") == std::make_tuple('A', ""));
+  CHECK(alphanum("1") == std::make_tuple('1', ""));
+  CHECK(alphanum("a") == std::make_tuple('a', ""));
+  CHECK(alphanum("A") == std::make_tuple('A', ""));
+  CHECK(sign("-") == std::make_tuple('-', ""));
+  CHECK(sign("+") == std::make_tuple('+', ""));
+  CHECK(space(" ") == std::make_tuple(' ', ""));
+  CHECK(space("\n") == std::make_tuple('\n', ""));
+  CHECK(dot(".") == std::make_tuple('.', ""));
+  CHECK(semi(";") == std::make_tuple(';', ""));
+  CHECK(comma(",") == std::make_tuple(',', ""));
+  CHECK(colon(":") == std::make_tuple(':', ""));
+  CHECK(quota("\"") == std::make_tuple('"', ""));
+
+  static_assert(digit("a").has_value() == false);
+  static_assert(digit("1") == std::make_tuple('1', ""));
+  static_assert(octdigit("8").has_value() == false);
+  static_assert(octdigit("1") == std::make_tuple('1', ""));
+  static_assert(hexdigit("x").has_value() == false);
+  static_assert(hexdigit("1") == std::make_tuple('1', ""));
+  static_assert(hexdigit("a") == std::make_tuple('a', ""));
+  static_assert(lower("A").has_value() == false);
+  static_assert(lower("a") == std::make_tuple('a', ""));
+  static_assert(upper("a").has_value() == false);
+  static_assert(upper("A") == std::make_tuple('A', ""));
+  static_assert(alpha("0").has_value() == false);
+  static_assert(alpha("a") == std::make_tuple('a', ""));
+  static_assert(alpha("A") == std::make_tuple('A', ""));
+  static_assert(alphanum("1") == std::make_tuple('1', ""));
+  static_assert(alphanum("a") == std::make_tuple('a', ""));
+  static_assert(alphanum("A") == std::make_tuple('A', ""));
+  static_assert(sign("-") == std::make_tuple('-', ""));
+  static_assert(sign("+") == std::make_tuple('+', ""));
+  static_assert(space(" ") == std::make_tuple(' ', ""));
+  static_assert(space("\n") == std::make_tuple('\n', ""));
+  static_assert(dot(".") == std::make_tuple('.', ""));
+  static_assert(semi(";") == std::make_tuple(';', ""));
+  static_assert(comma(",") == std::make_tuple(',', ""));
+  static_assert(colon(":") == std::make_tuple(':', ""));
+  static_assert(quota("\"") == std::make_tuple('"', ""));
 }
\ No newline at end of file
@@ -1,189 +1,462 @@
-#include <doctest/doctest.h>
-#include <parserc/character.h>
-#include <parserc/combinator.h>
-
-using namespace parsec;
-
-TEST_CASE("seq") {
-  constexpr auto parse = one_of<'a'> + one_of<'b'>;
-  constexpr auto value = std::make_tuple('a', 'b');
-
-  static_assert(parse("ba").has_value() == false);
-  static_assert(parse("ab") == std::make_tuple(value, ""));
-  static_assert(parse("abc") == std::make_tuple(value, "c"));
-
-  CHECK(parse("ba").has_value() == false);
-  CHECK(parse("ab") == std::make_tuple(value, ""));
-  CHECK(parse("abc") == std::make_tuple(value, "c"));
-}
-
-TEST_CASE("choice") {
-  constexpr auto parse = one_of<'a'> || one_of<'b'>;
-
-  static_assert(parse("c").has_value() == false);
-  static_assert(parse("a") == std::make_tuple('a', ""));
-  static_assert(parse("b") == std::make_tuple('b', ""));
-  static_assert(parse("ab") == std::make_tuple('a', "b"));
-
-  CHECK(parse("c").has_value() == false);
-  CHECK(parse("a") == std::make_tuple('a', ""));
-  CHECK(parse("b") == std::make_tuple('b', ""));
-  CHECK(parse("ab") == std::make_tuple('a', "b"));
-}
-
-TEST_CASE("left") {
-  constexpr auto parse = left(one_of<'a'>, one_of<'b'>);
-
-  static_assert(parse("ba").has_value() == false);
-  static_assert(parse("ab") == std::make_tuple('a', ""));
-  static_assert(parse("abc") == std::make_tuple('a', "c"));
-
-  CHECK(parse("ba").has_value() == false);
-  CHECK(parse("ab") == std::make_tuple('a', ""));
-  CHECK(parse("abc") == std::make_tuple('a', "c"));
-}
-
-TEST_CASE("right") {
-  constexpr auto parse = right(one_of<'a'>, one_of<'b'>);
-
-  static_assert(parse("ba").has_value() == false);
-  static_assert(parse("ab") == std::make_tuple('b', ""));
-  static_assert(parse("abc") == std::make_tuple('b', "c"));
-
-  CHECK(parse("ba").has_value() == false);
-  CHECK(parse("ab") == std::make_tuple('b', ""));
-  CHECK(parse("abc") == std::make_tuple('b', "c"));
-}
-
-TEST_CASE("between") {
-  constexpr auto parse = between(one_of<'a'>, one_of<'b'>, one_of<'c'>);
-
-  static_assert(parse("bac").has_value() == false);
-  static_assert(parse("abc") == std::make_tuple('b', ""));
-  static_assert(parse("abcd") == std::make_tuple('b', "d"));
-
-  CHECK(parse("bac").has_value() == false);
-  CHECK(parse("abc") == std::make_tuple('b', ""));
-  CHECK(parse("abcd") == std::make_tuple('b', "d"));
-}
-
-TEST_CASE("many") {
-  constexpr auto parse = many(one_of<'a'>);
-  constexpr auto value = [](std::size_t count) {
-    return std::vector<char>(count, 'a');
-  };
-
-  static_assert(parse("") == std::make_tuple(value(0), ""));
-  static_assert(parse("b") == std::make_tuple(value(0), "b"));
-  static_assert(parse("a") == std::make_tuple(value(1), ""));
-  static_assert(parse("aaa") == std::make_tuple(value(3), ""));
-  static_assert(parse("aaab") == std::make_tuple(value(3), "b"));
-
-  CHECK(parse("") == std::make_tuple(value(0), ""));
-  CHECK(parse("b") == std::make_tuple(value(0), "b"));
-  CHECK(parse("a") == std::make_tuple(value(1), ""));
-  CHECK(parse("aaa") == std::make_tuple(value(3), ""));
-  CHECK(parse("aaab") == std::make_tuple(value(3), "b"));
-}
-
-TEST_CASE("many1") {
-  constexpr auto parse = many1(one_of<'a'>);
-  constexpr auto value = [](std::size_t count) {
-    return std::vector<char>(count, 'a');
-  };
-
-  static_assert(parse("").has_value() == false);
-  static_assert(parse("b").has_value() == false);
-  static_assert(parse("a") == std::make_tuple(value(1), ""));
-  static_assert(parse("aaa") == std::make_tuple(value(3), ""));
-  static_assert(parse("aaab") == std::make_tuple(value(3), "b"));
-
-  CHECK(parse("").has_value() == false);
-  CHECK(parse("b").has_value() == false);
-  CHECK(parse("a") == std::make_tuple(value(1), ""));
-  CHECK(parse("aaa") == std::make_tuple(value(3), ""));
-  CHECK(parse("aaab") == std::make_tuple(value(3), "b"));
-}
-
-TEST_CASE("many<N>") {
-  constexpr auto parse = many<3>(one_of<'a'>);
-  constexpr auto value = std::array<char, 3>{ 'a', 'a', 'a' };
-
-  static_assert(parse("aa").has_value() == false);
-  static_assert(parse("aaa") == std::make_tuple(value, ""));
-  static_assert(parse("aaaa") == std::make_tuple(value, "a"));
-  static_assert(parse("aaab") == std::make_tuple(value, "b"));
-
-  CHECK(parse("aa").has_value() == false);
-  CHECK(parse("aaa") == std::make_tuple(value, ""));
-  CHECK(parse("aaaa") == std::make_tuple(value, "a"));
-  CHECK(parse("aaab") == std::make_tuple(value, "b"));
-}
-
-TEST_CASE("sepby") {
-  constexpr auto parse = sepby(one_of<'a'>, one_of<','>);
-  constexpr auto value = [](std::size_t count) {
-    return std::vector<char>(count, 'a');
-  };
-
-  static_assert(parse("") == std::make_tuple(value(0), ""));
-  static_assert(parse("b") == std::make_tuple(value(0), "b"));
-  static_assert(parse("a") == std::make_tuple(value(1), ""));
-  static_assert(parse("a,") == std::make_tuple(value(1), ","));
-  static_assert(parse("a,b") == std::make_tuple(value(1), ",b"));
-  static_assert(parse("a,a,a") == std::make_tuple(value(3), ""));
-
-  CHECK(parse("") == std::make_tuple(value(0), ""));
-  CHECK(parse("b") == std::make_tuple(value(0), "b"));
-  CHECK(parse("a") == std::make_tuple(value(1), ""));
-  CHECK(parse("a,") == std::make_tuple(value(1), ","));
-  CHECK(parse("a,b") == std::make_tuple(value(1), ",b"));
-  CHECK(parse("a,a,a") == std::make_tuple(value(3), ""));
-}
-
-TEST_CASE("sepby1") {
-  constexpr auto parse = sepby1(one_of<'a'>, one_of<','>);
-  constexpr auto value = [](std::size_t count) {
-    return std::vector<char>(count, 'a');
-  };
-
-  static_assert(parse("").has_value() == false);
-  static_assert(parse("b").has_value() == false);
-  static_assert(parse("a") == std::make_tuple(value(1), ""));
-  static_assert(parse("a,") == std::make_tuple(value(1), ","));
-  static_assert(parse("a,b") == std::make_tuple(value(1), ",b"));
-  static_assert(parse("a,a,a") == std::make_tuple(value(3), ""));
-
-  CHECK(parse("").has_value() == false);
-  CHECK(parse("b").has_value() == false);
-  CHECK(parse("a") == std::make_tuple(value(1), ""));
-  CHECK(parse("a,") == std::make_tuple(value(1), ","));
-  CHECK(parse("a,b") == std::make_tuple(value(1), ",b"));
-  CHECK(parse("a,a,a") == std::make_tuple(value(3), ""));
-  CHECK(parse("a,a,a") == std::make_tuple(value(3), ""));
-}
-
-TEST_CASE("sepby<N>") {
-  constexpr auto parse = sepby<3>(one_of<'a'>, one_of<','>);
-  constexpr auto value = std::array<char, 3>{ 'a', 'a', 'a' };
-
-  static_assert(parse("a,a").has_value() == false);
-  static_assert(parse("a,a,a") == std::make_tuple(value, ""));
-  static_assert(parse("a,a,a,a") == std::make_tuple(value, ",a"));
-  static_assert(parse("a,a,a,b") == std::make_tuple(value, ",b"));
-
-  CHECK(parse("a,a").has_value() == false);
-  CHECK(parse("a,a,a") == std::make_tuple(value, ""));
-  CHECK(parse("a,a,a,a") == std::make_tuple(value, ",a"));
-  CHECK(parse("a,a,a,b") == std::make_tuple(value, ",b"));
-}
-
-TEST_CASE("eof") {
-  constexpr auto parse = eof(one_of<'a'>);
-
-  static_assert(parse("ab").has_value() == false);
-  static_assert(parse("a") == std::make_tuple('a', ""));
-
-  CHECK(parse("ab").has_value() == false);
-  CHECK(parse("a") == std::make_tuple('a', ""));
+#include <doctest/doctest.h>
+#include <parserc/character.h>
+#include <parserc/combinator.h>
+#include <parserc/token.h>
+
+#include <memory>
+
+using namespace parsec;
+
+TEST_CASE("seq") {
+  constexpr auto parse = one_of<'a'> + one_of<'b'>;
+  constexpr auto value = std::make_tuple('a', 'b');
+
+  static_assert(parse("ba").has_value() == false);
+  static_assert(parse("ab") == std::make_tuple(value, ""));
+  static_assert(parse("abc") == std::make_tuple(value, "c"));
+
+  CHECK(parse("ba").has_value() == false);
+  CHECK(parse("ab") == std::make_tuple(value, ""));
+  CHECK(parse("abc") == std::make_tuple(value, "c"));
+
+  // sequences are flat, and skipped values are not kept.
+  constexpr auto abc = parse + one_of<'c'>;
+  static_assert(abc("abcd") == std::make_tuple(std::make_tuple('a', 'b', 'c'), "d"));
+  CHECK(abc("abcd") == std::make_tuple(std::make_tuple('a', 'b', 'c'), "d"));
+
+  static_assert(seq(one_of<'a'>, one_of<'b'> + one_of<'c'>)("abc") == std::make_tuple(std::make_tuple('a', 'b', 'c'), ""));
+  CHECK(seq(one_of<'a'>, one_of<'b'> + one_of<'c'>)("abc") == std::make_tuple(std::make_tuple('a', 'b', 'c'), ""));
+
+  constexpr auto ac = seq(one_of<'a'>, skip(one_of<'b'>), one_of<'c'>);
+  static_assert(ac("abc") == std::make_tuple(std::make_tuple('a', 'c'), ""));
+  CHECK(ac("abc") == std::make_tuple(std::make_tuple('a', 'c'), ""));
+
+  static_assert((skip(one_of<'a'>) + one_of<'b'>)("ab") == std::make_tuple('b', ""));
+  CHECK((skip(one_of<'a'>) + one_of<'b'>)("ab") == std::make_tuple('b', ""));
+
+  static_assert(ac("acb").has_value() == false);
+  CHECK(ac("acb").has_value() == false);
+}
+
+TEST_CASE("choice") {
+  constexpr auto parse = one_of<'a'> || one_of<'b'>;
+
+  static_assert(parse("c").has_value() == false);
+  static_assert(parse("a") == std::make_tuple('a', ""));
+  static_assert(parse("b") == std::make_tuple('b', ""));
+  static_assert(parse("ab") == std::make_tuple('a', "b"));
+
+  CHECK(parse("c").has_value() == false);
+  CHECK(parse("a") == std::make_tuple('a', ""));
+  CHECK(parse("b") == std::make_tuple('b', ""));
+  CHECK(parse("ab") == std::make_tuple('a', "b"));
+}
+
+TEST_CASE("first set") {
+  constexpr auto a = one_of<'a'>;
+  constexpr auto b = one_of<'b'>;
+
+  static_assert(first_v<decltype(a)> == charmap::of('a') && !nullable_v<decltype(a)>);
+  static_assert(first_v<decltype(a + b)> == charmap::of('a') && !nullable_v<decltype(a + b)>);
+  static_assert(first_v<decltype(many(a) + b)> == ~charmap{} && nullable_v<decltype(many(a) + b)> == false);
+  static_assert(first_v<decltype(right(a, b))> == charmap::of('a'));
+  static_assert(first_v<decltype(many1(a + b))> == charmap::of('a'));
+  static_assert(first_v<decltype(a + b || b + a)> == charmap::of('a', 'b'));
+  static_assert(nullable_v<decltype(many(a))> && nullable_v<decltype(a + b || success<std::tuple<char, char>>())>);
+}
+
+TEST_CASE("choice dispatch") {
+  constexpr auto ab = one_of<'a'> + one_of<'b'>;
+  constexpr auto ac = one_of<'a'> + one_of<'c'>;
+  constexpr auto bc = one_of<'b'> + one_of<'c'>;
+  constexpr auto parse = ab || ac || bc;
+  constexpr auto value = [](char c1, char c2) { return std::make_tuple(c1, c2); };
+
+  static_assert(std::tuple_size_v<decltype(parse.parsers)> == 3);
+  static_assert(parse("ab") == std::make_tuple(value('a', 'b'), ""));
+  static_assert(parse("ac") == std::make_tuple(value('a', 'c'), ""));
+  static_assert(parse("bc") == std::make_tuple(value('b', 'c'), ""));
+  static_assert(parse("cc").has_value() == false);
+  static_assert(parse("").has_value() == false);
+  static_assert((parse || success<std::tuple<char, char>>())("") == std::make_tuple(value(0, 0), ""));
+
+  CHECK(parse("ab") == std::make_tuple(value('a', 'b'), ""));
+  CHECK(parse("ac") == std::make_tuple(value('a', 'c'), ""));
+  CHECK(parse("bc") == std::make_tuple(value('b', 'c'), ""));
+  CHECK(parse("cc").has_value() == false);
+  CHECK(parse("").has_value() == false);
+  CHECK((parse || success<std::tuple<char, char>>())("") == std::make_tuple(value(0, 0), ""));
+
+  // alternatives that cannot start with the next character are not tried.
+  static int calls = 0;
+  constexpr auto counted = detail::annotate<charmap::of('b'), false>([](const Input& input) {
+    calls++;
+    return one_of<'b'>(input);
+  });
+  constexpr auto guarded = one_of<'a'> || counted;
+  CHECK(guarded("a") == std::make_tuple('a', ""));
+  CHECK(guarded("c").has_value() == false);
+  CHECK(calls == 0);
+  CHECK(guarded("b") == std::make_tuple('b', ""));
+  CHECK(calls == 1);
+}
+
+TEST_CASE("error") {
+  constexpr auto ab = one_of<'a'> + one_of<'b'>;
+  constexpr auto parse = ab + one_of<'c'> + one_of<'d'> || ab + one_of<'x'> + one_of<'y'>;
+  constexpr Input input = "abcx";
+
+  static_assert(ab("ax").error() == Error{ Input("x"), "parser does not satisfy." });
+  static_assert(ab("ax").error().offset("ax") == 1);
+  static_assert(parse("ab").error().offset("ab") == 2);
+  // the furthest failure of the alternatives.
+  static_assert(parse(input).error().offset(input) == 3);
+  static_assert(eof(ab)("abc").error() == Error{ Input("c"), "not end of input" });
+  static_assert(Error{ Input("x"), "" }.location("ab\ncd\nex") == Location{ 3, 2 });
+  static_assert(Error{ Input("cd"), "" }.location("ab\ncd") == Location{ 2, 1 });
+  static_assert(Error{ Input("b"), "" }.location("ab") == Location{ 1, 2 });
+
+  CHECK(ab("ax").error() == Error{ Input("x"), "parser does not satisfy." });
+  CHECK(parse(input).error().offset(input) == 3);
+  CHECK(Error{ Input("x"), "" }.location("ab\ncd\nex") == Location{ 3, 2 });
+  CHECK(parse("a\n").error().message("a\n") == "1:2: parser does not satisfy.");
+}
+
+TEST_CASE("commit") {
+  // the request lines of two methods, committed once the method has matched.
+  constexpr auto path = skip(one_of<'/'>) + many(lower);
+  constexpr auto get = seq(skip(lit<"GET ">), commit(path));
+  constexpr auto post = seq(skip(lit<"POST ">), commit(path));
+  constexpr auto fallback = slice(many(upper)) | map([](Input) { return std::vector<char>{}; });
+  constexpr auto parse = get || post || fallback;
+
+  static_assert(parse("GET /ab") == std::make_tuple(std::vector<char>{ 'a', 'b' }, ""));
+  static_assert(parse("PUT /ab") == std::make_tuple(std::vector<char>{}, " /ab"));
+  // a failure past the method is not retried by the fallback.
+  static_assert(parse("GET ab").has_value() == false);
+  static_assert(parse("GET ab").error().committed);
+  static_assert(parse("GET ab").error().offset("GET ab") == 4);
+
+  CHECK(parse("POST /x") == std::make_tuple(std::vector<char>{ 'x' }, ""));
+  CHECK(parse("PUT /ab") == std::make_tuple(std::vector<char>{}, " /ab"));
+  CHECK(parse("GET ab").has_value() == false);
+  CHECK(parse("GET ab").error().offset("GET ab") == 4);
+
+  // repetitions fail instead of stopping at a committed failure.
+  constexpr auto pairs = many(seq(skip(one_of<'('>), commit(left(digit, one_of<')'>))));
+  static_assert(pairs("(1)(2)x") == std::make_tuple(std::vector<char>{ '1', '2' }, "x"));
+  static_assert(pairs("(1)(2x").error().offset("(1)(2x") == 5);
+  static_assert(count(pairs)("(1)(x").has_value() == false);
+  static_assert(skip_many(pairs)("(1)(x").has_value() == false);
+
+  CHECK(pairs("(1)(2x").error().offset("(1)(2x") == 5);
+  CHECK(sepby(seq(skip(one_of<'('>), commit(digit)), one_of<','>)("(1,(x").has_value() == false);
+  CHECK(many_into(seq(skip(one_of<'('>), commit(digit)), [](char) {})("(1(x").has_value() == false);
+
+  // fixed repetitions fail with the committed failure, which cuts a choice.
+  constexpr auto pair = seq(skip(one_of<'('>), commit(digit));
+  constexpr auto triple = many<3>(pair) || success<std::array<char, 3>>();
+  constexpr auto list = sepby<3>(pair, one_of<','>) || success<std::array<char, 3>>();
+  static_assert(triple("(1(2(3") == std::make_tuple(std::array<char, 3>{ '1', '2', '3' }, ""));
+  static_assert(triple("(1(2(x").error().committed);
+  static_assert(triple("(1(2(x").error().offset("(1(2(x") == 5);
+  static_assert(list("(1,(x").error().offset("(1,(x") == 4);
+  static_assert(list(",").has_value());
+  static_assert(triple("(1)").has_value());
+
+  CHECK(triple("(1(2(x").error().offset("(1(2(x") == 5);
+  CHECK(list("(1,(x").error().committed);
+  CHECK(list(",").has_value());
+}
+
+TEST_CASE("attempt") {
+  constexpr auto get = seq(skip(lit<"GET ">), commit(skip(one_of<'/'>) + many(lower)));
+  constexpr auto parse = attempt(get) || success<std::vector<char>>();
+
+  static_assert(get("GET ab").error().committed);
+  static_assert(parse("GET ab") == std::make_tuple(std::vector<char>{}, "GET ab"));
+  CHECK(parse("GET ab") == std::make_tuple(std::vector<char>{}, "GET ab"));
+  CHECK(parse("GET /ab") == std::make_tuple(std::vector<char>{ 'a', 'b' }, ""));
+}
+
+TEST_CASE("left") {
+  constexpr auto parse = left(one_of<'a'>, one_of<'b'>);
+
+  static_assert(parse("ba").has_value() == false);
+  static_assert(parse("ab") == std::make_tuple('a', ""));
+  static_assert(parse("abc") == std::make_tuple('a', "c"));
+
+  CHECK(parse("ba").has_value() == false);
+  CHECK(parse("ab") == std::make_tuple('a', ""));
+  CHECK(parse("abc") == std::make_tuple('a', "c"));
+}
+
+TEST_CASE("right") {
+  constexpr auto parse = right(one_of<'a'>, one_of<'b'>);
+
+  static_assert(parse("ba").has_value() == false);
+  static_assert(parse("ab") == std::make_tuple('b', ""));
+  static_assert(parse("abc") == std::make_tuple('b', "c"));
+
+  CHECK(parse("ba").has_value() == false);
+  CHECK(parse("ab") == std::make_tuple('b', ""));
+  CHECK(parse("abc") == std::make_tuple('b', "c"));
+}
+
+TEST_CASE("between") {
+  constexpr auto parse = between(one_of<'a'>, one_of<'b'>, one_of<'c'>);
+
+  static_assert(parse("bac").has_value() == false);
+  static_assert(parse("abc") == std::make_tuple('b', ""));
+  static_assert(parse("abcd") == std::make_tuple('b', "d"));
+
+  CHECK(parse("bac").has_value() == false);
+  CHECK(parse("abc") == std::make_tuple('b', ""));
+  CHECK(parse("abcd") == std::make_tuple('b', "d"));
+}
+
+TEST_CASE("many") {
+  constexpr auto parse = many(one_of<'a'>);
+  constexpr auto value = [](std::size_t count) {
+    return std::vector<char>(count, 'a');
+  };
+
+  static_assert(parse("") == std::make_tuple(value(0), ""));
+  static_assert(parse("b") == std::make_tuple(value(0), "b"));
+  static_assert(parse("a") == std::make_tuple(value(1), ""));
+  static_assert(parse("aaa") == std::make_tuple(value(3), ""));
+  static_assert(parse("aaab") == std::make_tuple(value(3), "b"));
+
+  CHECK(parse("") == std::make_tuple(value(0), ""));
+  CHECK(parse("b") == std::make_tuple(value(0), "b"));
+  CHECK(parse("a") == std::make_tuple(value(1), ""));
+  CHECK(parse("aaa") == std::make_tuple(value(3), ""));
+  CHECK(parse("aaab") == std::make_tuple(value(3), "b"));
+}
+
+TEST_CASE("many1") {
+  constexpr auto parse = many1(one_of<'a'>);
+  constexpr auto value = [](std::size_t count) {
+    return std::vector<char>(count, 'a');
+  };
+
+  static_assert(parse("").has_value() == false);
+  static_assert(parse("b").has_value() == false);
+  static_assert(parse("a") == std::make_tuple(value(1), ""));
+  static_assert(parse("aaa") == std::make_tuple(value(3), ""));
+  static_assert(parse("aaab") == std::make_tuple(value(3), "b"));
+
+  CHECK(parse("").has_value() == false);
+  CHECK(parse("b").has_value() == false);
+  CHECK(parse("a") == std::make_tuple(value(1), ""));
+  CHECK(parse("aaa") == std::make_tuple(value(3), ""));
+  CHECK(parse("aaab") == std::make_tuple(value(3), "b"));
+}
+
+TEST_CASE("many<N>") {
+  constexpr auto parse = many<3>(one_of<'a'>);
+  constexpr auto value = std::array<char, 3>{ 'a', 'a', 'a' };
+
+  static_assert(parse("aa").has_value() == false);
+  static_assert(parse("aaa") == std::make_tuple(value, ""));
+  static_assert(parse("aaaa") == std::make_tuple(value, "a"));
+  static_assert(parse("aaab") == std::make_tuple(value, "b"));
+
+  CHECK(parse("aa").has_value() == false);
+  CHECK(parse("aaa") == std::make_tuple(value, ""));
+  CHECK(parse("aaaa") == std::make_tuple(value, "a"));
+  CHECK(parse("aaab") == std::make_tuple(value, "b"));
+}
+
+TEST_CASE("fold_many") {
+  constexpr auto parse = fold_many(one_of<'1'>, 0, [](int n, char) {
+    return n + 1;
+  });
+
+  static_assert(parse("") == std::make_tuple(0, ""));
+  static_assert(parse("b") == std::make_tuple(0, "b"));
+  static_assert(parse("111b") == std::make_tuple(3, "b"));
+
+  CHECK(parse("") == std::make_tuple(0, ""));
+  CHECK(parse("b") == std::make_tuple(0, "b"));
+  CHECK(parse("111b") == std::make_tuple(3, "b"));
+}
+
+TEST_CASE("fold_many1") {
+  constexpr auto parse = fold_many1(one_of<'1'>, 0, [](int n, char) {
+    return n + 1;
+  });
+
+  static_assert(parse("").has_value() == false);
+  static_assert(parse("b").has_value() == false);
+  static_assert(parse("111b") == std::make_tuple(3, "b"));
+
+  CHECK(parse("").has_value() == false);
+  CHECK(parse("b").has_value() == false);
+  CHECK(parse("111b") == std::make_tuple(3, "b"));
+}
+
+TEST_CASE("count") {
+  constexpr auto parse = count(one_of<'a'>);
+
+  static_assert(parse("") == std::make_tuple(0, ""));
+  static_assert(parse("aaab") == std::make_tuple(3, "b"));
+
+  CHECK(parse("") == std::make_tuple(0, ""));
+  CHECK(parse("aaab") == std::make_tuple(3, "b"));
+}
+
+TEST_CASE("skip_many") {
+  constexpr auto parse = skip_many(one_of<'a'>);
+
+  static_assert(parse("") == std::make_tuple("", ""));
+  static_assert(parse("b") == std::make_tuple("", "b"));
+  static_assert(parse("aaab") == std::make_tuple("aaa", "b"));
+
+  CHECK(parse("") == std::make_tuple("", ""));
+  CHECK(parse("b") == std::make_tuple("", "b"));
+  CHECK(parse("aaab") == std::make_tuple("aaa", "b"));
+}
+
+TEST_CASE("sepby") {
+  constexpr auto parse = sepby(one_of<'a'>, one_of<','>);
+  constexpr auto value = [](std::size_t count) {
+    return std::vector<char>(count, 'a');
+  };
+
+  static_assert(parse("") == std::make_tuple(value(0), ""));
+  static_assert(parse("b") == std::make_tuple(value(0), "b"));
+  static_assert(parse("a") == std::make_tuple(value(1), ""));
+  static_assert(parse("a,") == std::make_tuple(value(1), ","));
+  static_assert(parse("a,b") == std::make_tuple(value(1), ",b"));
+  static_assert(parse("a,a,a") == std::make_tuple(value(3), ""));
+
+  CHECK(parse("") == std::make_tuple(value(0), ""));
+  CHECK(parse("b") == std::make_tuple(value(0), "b"));
+  CHECK(parse("a") == std::make_tuple(value(1), ""));
+  CHECK(parse("a,") == std::make_tuple(value(1), ","));
+  CHECK(parse("a,b") == std::make_tuple(value(1), ",b"));
+  CHECK(parse("a,a,a") == std::make_tuple(value(3), ""));
+}
+
+TEST_CASE("sepby1") {
+  constexpr auto parse = sepby1(one_of<'a'>, one_of<','>);
+  constexpr auto value = [](std::size_t count) {
+    return std::vector<char>(count, 'a');
+  };
+
+  static_assert(parse("").has_value() == false);
+  static_assert(parse("b").has_value() == false);
+  static_assert(parse("a") == std::make_tuple(value(1), ""));
+  static_assert(parse("a,") == std::make_tuple(value(1), ","));
+  static_assert(parse("a,b") == std::make_tuple(value(1), ",b"));
+  static_assert(parse("a,a,a") == std::make_tuple(value(3), ""));
+
+  CHECK(parse("").has_value() == false);
+  CHECK(parse("b").has_value() == false);
+  CHECK(parse("a") == std::make_tuple(value(1), ""));
+  CHECK(parse("a,") == std::make_tuple(value(1), ","));
+  CHECK(parse("a,b") == std::make_tuple(value(1), ",b"));
+  CHECK(parse("a,a,a") == std::make_tuple(value(3), ""));
+  CHECK(parse("a,a,a") == std::make_tuple(value(3), ""));
+}
+
+TEST_CASE("sepby<N>") {
+  constexpr auto parse = sepby<3>(one_of<'a'>, one_of<','>);
+  constexpr auto value = std::array<char, 3>{ 'a', 'a', 'a' };
+
+  static_assert(parse("a,a").has_value() == false);
+  static_assert(parse("a,a,a") == std::make_tuple(value, ""));
+  static_assert(parse("a,a,a,a") == std::make_tuple(value, ",a"));
+  static_assert(parse("a,a,a,b") == std::make_tuple(value, ",b"));
+
+  CHECK(parse("a,a").has_value() == false);
+  CHECK(parse("a,a,a") == std::make_tuple(value, ""));
+  CHECK(parse("a,a,a,a") == std::make_tuple(value, ",a"));
+  CHECK(parse("a,a,a,b") == std::make_tuple(value, ",b"));
+}
+
+TEST_CASE("many_into") {
+  static_assert([] {
+    std::array<char, 4> out{};
+    auto result = many_into(one_of<'a'>, out.begin())("aaab");
+    return result == std::make_tuple(3, "b") && out == std::array<char, 4>{ 'a', 'a', 'a', 0 };
+  }());
+  static_assert(many1_into(one_of<'a'>, [](char) {})("b").has_value() == false);
+  static_assert(first_v<decltype(many1_into(one_of<'a'>, [](char) {}))> == charmap::of('a'));
+
+  std::string out;
+  CHECK(many_into(one_of<'a'>, std::back_inserter(out))("aaab") == std::make_tuple(3, "b"));
+  CHECK(out == "aaa");
+
+  // a bounded consumer: the records are handed over as they are parsed.
+  std::array<char, 4> ring{};
+  std::size_t written = 0;
+  int sum = 0;
+  auto consume = [&](char value) {
+    if (written == ring.size()) {
+      for (auto c : ring) {
+        sum += c - '0';
+      }
+      written = 0;
+    }
+    ring[written++] = value;
+  };
+  std::string input;
+  for (int i = 0; i < 1000; i++) {
+    input += std::to_string(i % 10) + ",";
+  }
+  CHECK(many_into(left(digit, comma), consume)(input) == std::make_tuple(1000, ""));
+  for (std::size_t i = 0; i < written; i++) {
+    sum += ring[i] - '0';
+  }
+  CHECK(sum == 4500);
+}
+
+TEST_CASE("sepby_into") {
+  static_assert([] {
+    int sum = 0;
+    auto result = sepby_into(digit, comma, [&](char c) { sum += c - '0'; })("1,2,3;");
+    return result == std::make_tuple(3, ";") && sum == 6;
+  }());
+  static_assert(sepby_into(digit, comma, [](char) {})(";") == std::make_tuple(0, ";"));
+  static_assert(sepby1_into(digit, comma, [](char) {})(";").has_value() == false);
+
+  std::string out;
+  CHECK(sepby1_into(digit, comma, std::back_inserter(out))("1,2,3") == std::make_tuple(3, ""));
+  CHECK(out == "123");
+  CHECK(sepby_into(digit, comma, std::back_inserter(out))("4") == std::make_tuple(1, ""));
+  CHECK(out == "1234");
+}
+
+TEST_CASE("eof") {
+  constexpr auto parse = eof(one_of<'a'>);
+
+  static_assert(parse("ab").has_value() == false);
+  static_assert(parse("a") == std::make_tuple('a', ""));
+
+  CHECK(parse("ab").has_value() == false);
+  CHECK(parse("a") == std::make_tuple('a', ""));
+}
+
+TEST_CASE("move-only") {
+  constexpr auto boxed = one_of<'a'> | map([](char c) {
+    return std::make_unique<char>(c);
+  });
+
+  auto pair = (boxed + boxed)("aa");
+  CHECK(*std::get<0>(std::get<0>(pair.value())) == 'a');
+  CHECK(*std::get<1>(std::get<0>(pair.value())) == 'a');
+
+  auto list = many(boxed)("aaab");
+  CHECK(std::get<0>(list.value()).size() == 3);
+  CHECK(std::get<1>(list.value()) == "b");
+
+  CHECK(std::get<0>(many1(boxed)("aa").value()).size() == 2);
+  CHECK(std::get<0>(sepby(boxed, comma)("a,a,a").value()).size() == 3);
+
+  auto value = boxed | to([](auto&& ptr) {
+    return *ptr;
+  });
+  CHECK(value("a") == 'a');
 }
\ No newline at end of file
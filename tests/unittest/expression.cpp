@@ -0,0 +1,95 @@
+#include <doctest/doctest.h>
+#include <parserc/character.h>
+#include <parserc/expression.h>
+#include <parserc/rule.h>
+#include <parserc/token.h>
+
+#include <array>
+#include <string>
+
+using namespace parsec;
+
+namespace {
+
+constexpr int add(int a, int b) { return a + b; }
+constexpr int sub(int a, int b) { return a - b; }
+constexpr int mul(int a, int b) { return a * b; }
+constexpr int pow(int a, int b) {
+  int ret = 1;
+  for (int i = 0; i < b; i++) {
+    ret *= a;
+  }
+  return ret;
+}
+
+constexpr auto additive = keywords<"+", "-"> | map([](std::size_t index) { return index == 0 ? add : sub; });
+constexpr auto power = one_of<'^'> | map([](char) { return pow; });
+
+constexpr std::array table{
+  infix<int>{ 1, assoc::left, add },
+  infix<int>{ 1, assoc::left, sub },
+  infix<int>{ 2, assoc::left, mul },
+  infix<int>{ 3, assoc::right, pow },
+};
+constexpr auto op = keywords<"+", "-", "*", "^">;
+
+}  // namespace
+
+TEST_CASE("chainl1") {
+  static_assert(chainl1(decimal<int>, additive)("10-2-3") == std::make_tuple(5, ""));
+  CHECK(chainl1(decimal<int>, additive)("10-2-3") == std::make_tuple(5, ""));
+
+  static_assert(chainl1(decimal<int>, additive)("7") == std::make_tuple(7, ""));
+  CHECK(chainl1(decimal<int>, additive)("7") == std::make_tuple(7, ""));
+
+  // an operator without an operand after it is not consumed.
+  static_assert(chainl1(decimal<int>, additive)("1+2+") == std::make_tuple(3, "+"));
+  CHECK(chainl1(decimal<int>, additive)("1+2+") == std::make_tuple(3, "+"));
+
+  static_assert(chainl1(decimal<int>, additive)("-").has_value() == false);
+  CHECK(chainl1(decimal<int>, additive)("-").has_value() == false);
+}
+
+TEST_CASE("chainr1") {
+  static_assert(chainr1(decimal<int>, power)("2^3^2") == std::make_tuple(512, ""));
+  CHECK(chainr1(decimal<int>, power)("2^3^2") == std::make_tuple(512, ""));
+
+  static_assert(chainr1(decimal<int>, additive)("10-2-3") == std::make_tuple(11, ""));
+  CHECK(chainr1(decimal<int>, additive)("10-2-3") == std::make_tuple(11, ""));
+
+  // longer than the inline stack.
+  auto input = std::string("1");
+  for (int i = 0; i < 100; i++) {
+    input += "-1";
+  }
+  CHECK(chainr1(decimal<int>, additive)(input) == std::make_tuple(1, ""));
+}
+
+TEST_CASE("precedence") {
+  static_assert(precedence(decimal<int>, op, table)("1+2*3") == std::make_tuple(7, ""));
+  CHECK(precedence(decimal<int>, op, table)("1+2*3") == std::make_tuple(7, ""));
+
+  static_assert(precedence(decimal<int>, op, table)("2*3-4-1") == std::make_tuple(1, ""));
+  CHECK(precedence(decimal<int>, op, table)("2*3-4-1") == std::make_tuple(1, ""));
+
+  static_assert(precedence(decimal<int>, op, table)("1+2*3^2^2-1") == std::make_tuple(162, ""));
+  CHECK(precedence(decimal<int>, op, table)("1+2*3^2^2-1") == std::make_tuple(162, ""));
+
+  static_assert(precedence(decimal<int>, op, table)("2*3+") == std::make_tuple(6, "+"));
+  CHECK(precedence(decimal<int>, op, table)("2*3+") == std::make_tuple(6, "+"));
+
+  // parenthesized operands through a rule.
+  rule<int> expr;
+  const auto operand = between(one_of<'('>, expr, one_of<')'>) || decimal<int>;
+  const auto definition = precedence(operand, op, table);
+  expr = definition;
+  CHECK(expr("(1+2)*3") == std::make_tuple(9, ""));
+  CHECK(expr("2^(1+1)^3") == std::make_tuple(256, ""));
+
+  // a long expression does not recurse.
+  auto input = std::string("0");
+  for (int i = 0; i < 100000; i++) {
+    input += i % 2 ? "+1" : "*1";
+  }
+  CHECK(expr(input) == std::make_tuple(50000, ""));
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <doctest/doctest.h>
+#include <parserc/json.h>
+
+#include <string>
+
+using namespace parsec;
+
+TEST_CASE("json literals and numbers") {
+  CHECK(json::parse("null")->is<std::nullptr_t>());
+  CHECK(json::parse(" true ")->as<bool>() == true);
+  CHECK(json::parse("false")->as<bool>() == false);
+  CHECK(json::parse("nul").has_value() == false);
+  CHECK(json::parse("nullx").has_value() == false);
+
+  static_assert(json::number_parser("-12.5e1,") == std::make_tuple(-125.0, ","));
+  static_assert(json::number_parser("0") == std::make_tuple(0.0, ""));
+  CHECK(json::parse("1e400")->as<double>() == std::numeric_limits<double>::infinity());
+  CHECK(json::parse("0.1")->as<double>() == 0.1);
+  CHECK(json::parse("-0")->as<double>() == 0.0);
+  for (auto bad : { "01", "+1", ".5", "1.", "-", "1e", "1e+", "--1", "0x10" }) {
+    CHECK(json::parse(bad).has_value() == false);
+  }
+}
+
+TEST_CASE("json strings") {
+  constexpr auto s = json::string_parser;
+  static_assert(s(R"("abc")") == std::make_tuple(json::string{ "abc", false }, ""));
+  static_assert(s(R"("a\"b")") == std::make_tuple(json::string{ R"(a\"b)", true }, ""));
+  static_assert(s(R"("a\u00e9")") == std::make_tuple(json::string{ R"(a\u00e9)", true }, ""));
+  CHECK(s(R"("abc)").has_value() == false);
+  CHECK(s("\"a\nb\"").has_value() == false);
+  CHECK(s(R"("\x")").has_value() == false);
+  CHECK(s(R"("\u12g4")").has_value() == false);
+
+  // plain strings are views of the input.
+  std::string input = R"("hello")";
+  auto value = json::parse(input);
+  REQUIRE(value.has_value());
+  CHECK(value->as<json::string>().raw.data() == input.data() + 1);
+
+  auto unescape = [](std::string_view text) {
+    return json::unescape(std::get<0>(*json::string_parser(text)));
+  };
+  CHECK(unescape(R"("plain")") == "plain");
+  CHECK(unescape(R"("\"\\\/\b\f\n\r\t")") == "\"\\/\b\f\n\r\t");
+  CHECK(unescape(R"("\u0041\u00E9\u20ac")") == "A\xC3\xA9\xE2\x82\xAC");
+  CHECK(unescape(R"("\ud83d\ude00")") == "\xF0\x9F\x98\x80");
+  CHECK(unescape(R"("\ud83d")") == "\xEF\xBF\xBD");
+}
+
+TEST_CASE("json arrays and objects") {
+  auto value = json::parse(R"( { "a" : [1, 2.5, "x", [], {}], "b!": {"c": null} , "d":true } )");
+  REQUIRE(value.has_value());
+  auto& a = value->find("a")->as<json::array>();
+  CHECK(a.size() == 5);
+  CHECK(a[0].as<double>() == 1);
+  CHECK(a[2].as<json::string>().raw == "x");
+  CHECK(a[3].as<json::array>().empty());
+  CHECK(a[4].as<json::object>().empty());
+  CHECK(value->find("b!")->find("c")->is<std::nullptr_t>());
+  CHECK(value->find("d")->as<bool>());
+  CHECK(value->find("e") == nullptr);
+  CHECK(json::parse("[ ]")->as<json::array>().empty());
+
+  for (auto bad : { "[1,]", "[1 2]", "{\"a\"}", "{\"a\":1,}", "{a:1}", "[", "", " ", "[1]]" }) {
+    CHECK(json::parse(bad).has_value() == false);
+  }
+
+  // the failure is reported inside the element, not at the ']' the arrays miss.
+  std::string input = "[1, [2, x]]";
+  auto error = json::parse(input);
+  REQUIRE(error.has_value() == false);
+  CHECK(error.error().offset(input) == 8);
+
+  std::string member = "{\"a\": [true, nul]}";
+  CHECK(json::parse(member).error().message(member) == "1:14: keywords dismatches.");
+  std::string colon = "{\"a\" 1}";
+  CHECK(json::parse(colon).error().offset(colon) == 5);
+}
+
+TEST_CASE("json depth") {
+  auto nested = [](std::size_t depth) {
+    return std::string(depth, '[') + std::string(depth, ']');
+  };
+  CHECK(json::parse(nested(1000)).has_value());
+  auto deep = nested(100000);
+  CHECK(json::parse(deep).error().message(deep) == "1:1025: rule is nested too deep.");
+}
\ No newline at end of file
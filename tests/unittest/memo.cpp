@@ -0,0 +1,73 @@
+#include <doctest/doctest.h>
+#include <parserc/character.h>
+#include <parserc/memo.h>
+
+#include <string>
+
+using namespace parsec;
+
+TEST_CASE("memo") {
+  constexpr auto parse = memo(one_of<'a'> + one_of<'b'>) || memo(one_of<'c'>) + one_of<'d'>;
+  constexpr auto value = [](char c1, char c2) { return std::make_tuple(c1, c2); };
+
+  static_assert(first_v<decltype(memo(one_of<'a'>))> == charmap::of('a'));
+  static_assert(parse("ab") == std::make_tuple(value('a', 'b'), ""));
+  static_assert(parse("cd") == std::make_tuple(value('c', 'd'), ""));
+  static_assert(parse("ac").has_value() == false);
+
+  CHECK(parse("ab") == std::make_tuple(value('a', 'b'), ""));
+  CHECK(parse("cd") == std::make_tuple(value('c', 'd'), ""));
+  CHECK(parse("ac").has_value() == false);
+
+  std::string input = "ab";
+  memo_table table(input);
+  CHECK(parse(input) == std::make_tuple(value('a', 'b'), ""));
+  CHECK(parse(input) == std::make_tuple(value('a', 'b'), ""));
+  CHECK(table.size() == 1);
+}
+
+TEST_CASE("memo_table") {
+  static int calls = 0;
+  static constexpr auto counted = memo([](const Input& input) {
+    calls++;
+    return one_of<'a'>(input);
+  });
+  static constexpr auto backtrack = left(counted, one_of<'b'>) || left(counted, one_of<'c'>) || counted;
+
+  std::string input = "aaad";
+  CHECK(many(backtrack)(input) == std::make_tuple(std::vector<char>{ 'a', 'a', 'a' }, "d"));
+  CHECK(calls == 12);
+
+  calls = 0;
+  {
+    memo_table table(input);
+    CHECK(many(backtrack)(input) == std::make_tuple(std::vector<char>{ 'a', 'a', 'a' }, "d"));
+    // once at each offset, the last one fails.
+    CHECK(calls == 4);
+    CHECK(table.size() == 4);
+
+    // inputs that are not suffixes of the memoized input are not memoized.
+    CHECK(counted(Input(input).substr(0, 1)) == std::make_tuple('a', ""));
+    CHECK(calls == 5);
+
+    // nested tables are independent.
+    {
+      memo_table inner(input);
+      CHECK(counted(input) == std::make_tuple('a', "aad"));
+      CHECK(calls == 6);
+    }
+    CHECK(counted(input) == std::make_tuple('a', "aad"));
+    CHECK(calls == 6);
+
+    std::string other = "bb";
+    table.reset(other);
+    CHECK(table.size() == 0);
+    CHECK(counted(other).has_value() == false);
+    CHECK(counted(other).has_value() == false);
+    CHECK(calls == 7);
+  }
+
+  // without a table, nothing is memoized.
+  CHECK(counted(input) == std::make_tuple('a', "aad"));
+  CHECK(calls == 8);
+}
\ No newline at end of file
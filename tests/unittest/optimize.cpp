@@ -0,0 +1,91 @@
+#include <doctest/doctest.h>
+#include <parserc/character.h>
+#include <parserc/combinator.h>
+#include <parserc/optimize.h>
+#include <parserc/token.h>
+
+#include <tuple>
+
+using namespace parsec;
+
+TEST_CASE("lit") {
+  static_assert(lit<"GET">("GET /") == std::make_tuple("GET", " /"));
+  static_assert(lit<"GET">("GE").has_value() == false);
+
+  CHECK(lit<"GET">("GET /") == std::make_tuple("GET", " /"));
+  CHECK(lit<"GET">("GE").has_value() == false);
+}
+
+TEST_CASE("optimize merges literals") {
+  constexpr auto parse = seq(skip(one_of<'<'>), skip(one_of<'='>), skip(lit<"> ">), digit);
+  constexpr auto optimized = optimize(parse);
+  static_assert(std::same_as<std::remove_cvref_t<decltype(optimized)>,
+                             detail::seq_parser<detail::skipped<detail::literal<"<=> ">>, std::remove_cvref_t<decltype(digit)>>>);
+
+  static_assert(optimized("<=> 1") == std::make_tuple('1', ""));
+  static_assert(optimized("<=>1").has_value() == false);
+
+  CHECK(optimized("<=> 1").value() == parse("<=> 1").value());
+  CHECK(optimized("<=>1").has_value() == false);
+}
+
+TEST_CASE("optimize merges character sets") {
+  constexpr auto parse = (lit<"x"> | map([](std::string_view) { return 'x'; })) || digit || lower;
+  constexpr auto optimized = optimize(parse);
+  static_assert(std::tuple_size_v<decltype(optimized.parsers)> == 2);
+
+  static_assert(optimized("x") == std::make_tuple('x', ""));
+  static_assert(optimized("a") == std::make_tuple('a', ""));
+  static_assert(optimized("5") == std::make_tuple('5', ""));
+
+  CHECK(optimized("a").value() == parse("a").value());
+  CHECK(optimized("X").has_value() == false);
+}
+
+TEST_CASE("optimize factors prefixes") {
+  // the grammar of the error test.
+  constexpr auto ab = one_of<'a'> + one_of<'b'>;
+  constexpr auto parse = ab + one_of<'c'> + one_of<'d'> || ab + one_of<'x'> + one_of<'y'>;
+  constexpr auto optimized = optimize(parse);
+  static_assert(detail::is_seq_parser<std::remove_cvref_t<decltype(optimized)>>::value);
+
+  static_assert(optimized("abcd").value() == parse("abcd").value());
+  static_assert(optimized("abxy").value() == parse("abxy").value());
+  CHECK(optimized("abcd").value() == parse("abcd").value());
+  CHECK(optimized("abxy").value() == parse("abxy").value());
+  CHECK(optimized("abxd").has_value() == false);
+
+  // skipped literals are split after their common prefix.
+  constexpr auto header = seq(skip(lit<"Content-Length:">), decimal<int>) || seq(skip(lit<"Content-Type:">), decimal<int>) ||
+                          seq(skip(lit<"Connection:">), decimal<int>);
+  constexpr auto factored = optimize(header);
+  static_assert(detail::is_seq_parser<std::remove_cvref_t<decltype(factored)>>::value);
+  static_assert(std::same_as<std::remove_cvref_t<decltype(std::get<0>(factored.parsers))>, detail::skipped<detail::literal<"Con">>>);
+
+  static_assert(factored("Content-Type:7") == std::make_tuple(7, ""));
+  static_assert(factored("Connection:8") == std::make_tuple(8, ""));
+  CHECK(factored("Content-Length:12") == std::make_tuple(12, ""));
+  CHECK(factored("Content-Type:7") == std::make_tuple(7, ""));
+  CHECK(factored("Connection:8") == std::make_tuple(8, ""));
+  CHECK(factored("Content-Size:8").has_value() == false);
+
+  // the values after a kept prefix stay flat.
+  constexpr auto kept = digit + lower + lower || digit + upper + upper;
+  constexpr auto flat = optimize(kept);
+  static_assert(detail::is_seq_parser<std::remove_cvref_t<decltype(flat)>>::value);
+  static_assert(flat("1AB") == std::make_tuple(std::make_tuple('1', 'A', 'B'), ""));
+  CHECK(flat("1AB") == std::make_tuple(std::make_tuple('1', 'A', 'B'), ""));
+  CHECK(flat("1ab").value() == kept("1ab").value());
+}
+
+TEST_CASE("optimize skipped lists") {
+  constexpr auto parse = seq(skip(many(one_of<' '>)), many(lower), skip(many(lit<";">)));
+  constexpr auto optimized = optimize(parse);
+
+  CHECK(optimized("  ab;;c") == std::make_tuple(std::vector<char>{ 'a', 'b' }, "c"));
+  CHECK(optimized("ab").value() == parse("ab").value());
+
+  // a skip outside of a sequence keeps its value.
+  constexpr auto alone = optimize(skip(many(lower)));
+  CHECK(alone("ab") == std::make_tuple(std::vector<char>{ 'a', 'b' }, ""));
+}
\ No newline at end of file
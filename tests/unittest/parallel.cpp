@@ -0,0 +1,146 @@
+#include <doctest/doctest.h>
+#include <parserc/file.h>
+#include <parserc/parallel.h>
+#include <parserc/token.h>
+
+#include <atomic>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace parsec;
+
+TEST_CASE("thread_pool") {
+  thread_pool pool(4);
+  CHECK(pool.size() == 4);
+
+  for (std::size_t n : { 0, 1, 3, 1000 }) {
+    std::vector<std::atomic<int>> calls(n);
+    pool.for_each(n, [&](std::size_t i) { calls[i]++; });
+    CHECK(std::all_of(calls.begin(), calls.end(), [](auto& c) { return c == 1; }));
+  }
+
+  thread_pool single(1);
+  std::size_t sum = 0;
+  single.for_each(100, [&](std::size_t i) { sum += i; });
+  CHECK(sum == 4950);
+}
+
+TEST_CASE("thread_pool exception") {
+  thread_pool pool(4);
+
+  // tasks throw on the calling thread and on the workers.
+  for (std::size_t every : { 1, 7, 250 }) {
+    std::atomic<int> calls = 0;
+    CHECK_THROWS_AS(pool.for_each(1000, [&](std::size_t i) {
+      calls++;
+      if (i % every == 0) {
+        throw std::runtime_error("task");
+      }
+    }), std::runtime_error);
+    CHECK(calls <= 1000);
+  }
+
+  // the pool runs the next loop as usual.
+  std::atomic<std::size_t> sum = 0;
+  pool.for_each(100, [&](std::size_t i) { sum += i; });
+  CHECK(sum == 4950);
+}
+
+TEST_CASE("parse_parallel") {
+  constexpr auto line = left(decimal<int>, one_of<'\n'>);
+
+  std::string input;
+  for (int i = 0; i < 100000; i++) {
+    input += std::to_string(i) + "\n";
+  }
+  std::vector<int> expected(100000);
+  std::iota(expected.begin(), expected.end(), 0);
+
+  thread_pool pool(4);
+  CHECK(parse_parallel(line, input, '\n', pool) == expected);
+  CHECK(parse_parallel(line, input, '\n') == expected);
+  CHECK(parse_parallel(line, "", '\n', pool) == std::vector<int>{});
+
+  // a resync parser finds the records that start with "#".
+  constexpr auto group = right(one_of<'#'>, line) + count(line);
+  std::string groups;
+  for (int i = 0; i < 20000; i++) {
+    groups += "#" + std::to_string(i) + "\n";
+    for (int j = 0; j < i % 5; j++) {
+      groups += "7\n";
+    }
+  }
+  auto result = parse_parallel(group, groups, one_of<'#'>, pool);
+  REQUIRE(result.has_value());
+  CHECK(*result == std::get<0>(many(group)(groups).value()));
+
+  // errors have their offset in the whole input.
+  auto bad = input;
+  auto offset = bad.find("\n77777\n") + 3;
+  bad[offset] = 'x';
+  auto error = parse_parallel(line, bad, '\n', pool);
+  REQUIRE(error.has_value() == false);
+  CHECK(error.error().offset(bad) == offset);
+}
+
+TEST_CASE("parse_batch") {
+  static constexpr auto number = eof(decimal<int>);
+  static_assert([] {
+    Input inputs[] = { "1", "x", "22", "" };
+    int outputs[4] = { 0, -1, 0, -1 };
+    std::uint64_t parsed[1];
+    auto n = parse_batch(number, inputs, outputs, parsed);
+    return n == 2 && parsed[0] == 0b0101 && outputs[0] == 1 && outputs[1] == -1 && outputs[2] == 22;
+  }());
+
+  std::vector<std::string> strings;
+  for (int i = 0; i < 100000; i++) {
+    strings.push_back(i % 7 == 0 ? "bad" : std::to_string(i));
+  }
+  std::vector<Input> inputs(strings.begin(), strings.end());
+  std::vector<int> outputs(inputs.size());
+  std::vector<std::uint64_t> parsed(batch_words(inputs.size()));
+  CHECK(parse_batch(number, inputs, outputs, parsed) == 100000 - 14286);
+
+  thread_pool pool(4);
+  std::vector<int> sharded(inputs.size());
+  std::vector<std::uint64_t> sharded_parsed(batch_words(inputs.size()), ~std::uint64_t{ 0 });
+  CHECK(parse_batch(number, inputs, sharded, sharded_parsed, pool) == 100000 - 14286);
+  CHECK(sharded_parsed == parsed);
+  for (std::size_t i = 0; i < inputs.size(); i++) {
+    bool ok = parsed[i / 64] >> (i % 64) & 1;
+    CHECK(ok == (i % 7 != 0));
+    if (ok) {
+      CHECK(sharded[i] == static_cast<int>(i));
+    }
+  }
+
+  CHECK(parse_batch(number, std::span<const Input>{}, outputs, parsed, pool) == 0);
+}
+
+TEST_CASE("mapped_file") {
+  auto path = std::filesystem::temp_directory_path() / "parsec_mapped_file.txt";
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "1\n2\n3\n";
+  }
+
+  auto file = mapped_file::open(path);
+  REQUIRE(file.has_value());
+  CHECK(file->view() == "1\n2\n3\n");
+  CHECK(parse_parallel(left(decimal<int>, one_of<'\n'>), file->view(), '\n') == std::vector<int>{ 1, 2, 3 });
+
+  mapped_file moved = std::move(file).value();
+  CHECK(moved.size() == 6);
+
+  { std::ofstream out(path, std::ios::binary | std::ios::trunc); }
+  auto empty = mapped_file::open(path);
+  REQUIRE(empty.has_value());
+  CHECK(empty->view().empty());
+
+  std::filesystem::remove(path);
+  CHECK(mapped_file::open(path).has_value() == false);
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include <doctest/doctest.h>
+#include <parserc/character.h>
+#include <parserc/combinator.h>
+#include <parserc/optimize.h>
+#include <parserc/profile.h>
+#include <parserc/regular.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace parsec;
+
+// the tests run in the unittest target and again with PARSEC_PROFILE=1 in the
+// unittest_profile target.
+TEST_CASE("named") {
+  constexpr auto parse = named<"ab">(one_of<'a'> + one_of<'b'>);
+
+  // without PARSEC_PROFILE it is the parser itself.
+#if PARSEC_PROFILE
+  static_assert(std::same_as<std::remove_cvref_t<decltype(parse)>, detail::named_parser<"ab", decltype(one_of<'a'> + one_of<'b'>)>>);
+#else
+  static_assert(std::same_as<std::remove_cvref_t<decltype(parse)>, decltype(one_of<'a'> + one_of<'b'>)>);
+#endif
+  static_assert(parse("ab") == std::make_tuple(std::make_tuple('a', 'b'), ""));
+  CHECK(parse("ab") == std::make_tuple(std::make_tuple('a', 'b'), ""));
+}
+
+TEST_CASE("named grammar") {
+  // a grammar has the same values whether its rules are named parsers or not.
+  constexpr auto abc = named<"ab">(one_of<'a'> + one_of<'b'>) + one_of<'c'>;
+  constexpr auto a = named<"ab">(one_of<'a'> + skip(one_of<'b'>)) + skip(one_of<'c'>);
+  constexpr auto b = named<"none">(skip(one_of<'a'>)) + one_of<'b'>;
+  static_assert(std::same_as<invoke_parser_result_t<decltype(abc)>, std::tuple<char, char, char>>);
+  static_assert(std::same_as<invoke_parser_result_t<decltype(a)>, char>);
+  static_assert(std::same_as<invoke_parser_result_t<decltype(b)>, char>);
+  static_assert(abc("abc") == std::make_tuple(std::make_tuple('a', 'b', 'c'), ""));
+  static_assert(a("abc") == std::make_tuple('a', ""));
+  static_assert(b("ab") == std::make_tuple('b', ""));
+  CHECK(abc("abc") == std::make_tuple(std::make_tuple('a', 'b', 'c'), ""));
+
+  // regular() and optimize() see through the names.
+  constexpr auto number = regular(named<"digits">(digit + many(digit)) + skip(one_of<'.'>));
+  static_assert(number("12.3") == std::make_tuple("12.", "3"));
+  CHECK(number("12.3") == std::make_tuple("12.", "3"));
+
+  constexpr auto keyword = optimize(named<"a">(skip(lit<"ab">)) || named<"b">(skip(lit<"ac">)));
+  static_assert(std::same_as<std::remove_cvref_t<decltype(keyword)>, decltype(optimize(skip(lit<"ab">) || skip(lit<"ac">)))>);
+  static_assert(keyword("ac").has_value());
+  CHECK(keyword("ac").has_value());
+}
+
+TEST_CASE("profiler") {
+  constexpr auto digits = named<"digits">(skip_many(digit));
+  constexpr auto pair = named<"pair">(seq(digits, skip(one_of<','>), digits));
+  constexpr auto line = slice(pair) || digits;
+
+  static_assert(first_v<decltype(pair)> == first_v<decltype(digits)>);
+  static_assert(line("12,3") == std::make_tuple("12,3", ""));
+
+  std::string input = "12,3";
+  profiler profile;
+  CHECK(line(input) == std::make_tuple("12,3", ""));
+  CHECK(line("12;") == std::make_tuple("12", ";"));
+
+  // without PARSEC_PROFILE there are no rules to record.
+#if !PARSEC_PROFILE
+  CHECK(profile.rules().empty());
+  CHECK(profile.rule("pair").calls == 0);
+#else
+
+  auto p = profile.rule("pair");
+  CHECK(p.calls == 2);
+  CHECK(p.successes == 1);
+  CHECK(p.failures == 1);
+  // "12" was consumed before ';' failed.
+  CHECK(p.backtracks == 1);
+  CHECK(p.bytes == 4);
+
+  auto d = profile.rule("digits");
+  CHECK(d.calls == 4);
+  CHECK(d.successes == 4);
+  CHECK(d.bytes == 7);
+  CHECK(profile.rules().size() == 2);
+  CHECK(profile.rule("none").calls == 0);
+
+  std::ostringstream report;
+  profile.report(report);
+  CHECK(report.str().find("rule") == 0);
+  CHECK(report.str().find("digits") != std::string::npos);
+
+  // the stacks of the calls, digits is called by pair and by line.
+  std::ostringstream flame;
+  profile.flame(flame);
+  CHECK(flame.str().find("pair ") == 0);
+  CHECK(flame.str().find("\npair;digits ") != std::string::npos);
+  CHECK(flame.str().find("\ndigits ") != std::string::npos);
+
+  // profilers nest, the innermost one records.
+  profile.reset();
+  {
+    profiler inner;
+    CHECK(line(input).has_value());
+    CHECK(inner.rule("pair").calls == 1);
+  }
+  CHECK(profile.rule("pair").calls == 0);
+  CHECK(line(input).has_value());
+  CHECK(profile.rule("pair").calls == 1);
+#endif
+}
+
+TEST_CASE("profiler exception") {
+  constexpr auto digits = named<"digits">(skip_many(digit));
+  constexpr auto fail = named<"fail">(digit | map([](char) -> char { throw std::runtime_error("fail"); }));
+  constexpr auto line = named<"line">(seq(digits, skip(one_of<','>), fail));
+
+  profiler profile;
+  CHECK_THROWS_AS(line("12,3"), std::runtime_error);
+  CHECK_THROWS_AS(fail("1"), std::runtime_error);
+
+  // the calls after the throws are recorded at the top of the stack again.
+  CHECK(digits("1").has_value());
+#if PARSEC_PROFILE
+  std::ostringstream flame;
+  profile.flame(flame);
+  CHECK(flame.str().find("\ndigits ") != std::string::npos);
+  CHECK(flame.str().find(";fail;digits ") == std::string::npos);
+  CHECK(profile.rule("digits").calls == 2);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include <doctest/doctest.h>
+#include <parserc/character.h>
+#include <parserc/combinator.h>
+#include <parserc/regular.h>
+#include <parserc/token.h>
+
+#include <tuple>
+#include <type_traits>
+
+using namespace parsec;
+
+namespace {
+
+// the characters with a bit set.
+constexpr charmap bit(int k) {
+  charmap ret;
+  for (int c = 0; c < 256; c++) {
+    if ((c >> k) & 1) {
+      ret = ret | charmap::of(static_cast<char>(c));
+    }
+  }
+  return ret;
+}
+
+}  // namespace
+
+TEST_CASE("slice") {
+  constexpr auto parse = slice(digit + many(digit));
+
+  static_assert(parse("123a") == std::make_tuple("123", "a"));
+  static_assert(parse("a").has_value() == false);
+
+  CHECK(parse("123a") == std::make_tuple("123", "a"));
+  CHECK(parse("a").has_value() == false);
+
+  // slices of parsers of different values are alternatives of the same value.
+  constexpr auto zone = slice(one_of<'Z'>) || slice(one_of<'+', '-'> + digit + digit);
+  static_assert(zone("Z") == std::make_tuple("Z", ""));
+  static_assert(zone("+08:") == std::make_tuple("+08", ":"));
+  CHECK(zone("-05") == std::make_tuple("-05", ""));
+}
+
+TEST_CASE("regular") {
+  constexpr auto octet = digit + many(digit);
+  constexpr auto ipv4 = seq(octet, skip(dot), octet, skip(dot), octet, skip(dot), octet);
+  constexpr auto parse = regular(ipv4);
+
+  static_assert(parse("192.168.1.1 ") == std::make_tuple("192.168.1.1", " "));
+  static_assert(parse("192.168.1").has_value() == false);
+
+  CHECK(parse("192.168.1.1 ") == std::make_tuple("192.168.1.1", " "));
+  CHECK(parse("0.0.0.0") == std::make_tuple("0.0.0.0", ""));
+  CHECK(parse("192.168.1").has_value() == false);
+  CHECK(parse("1..2.3.4").has_value() == false);
+  CHECK(parse("").has_value() == false);
+
+  // the same input as the grammar.
+  CHECK(std::get<0>(parse("10.0.0.1x").value()) == std::get<0>(slice(ipv4)("10.0.0.1x").value()));
+}
+
+TEST_CASE("regular first set") {
+  constexpr auto parse = regular(slice(seq(lit<"0x">, many(one_of<'0', '1'>))) || slice(lower));
+
+  static_assert(decltype(parse)::first == (charmap::of('0') | charmap::range('a', 'z')));
+  static_assert(decltype(parse)::nullable == false);
+  static_assert(decltype(regular(many(lower)))::nullable == true);
+
+  static_assert(regular(many(lower))("123") == std::make_tuple("", "123"));
+  CHECK(regular(many(lower))("123") == std::make_tuple("", "123"));
+}
+
+TEST_CASE("regular classes") {
+  // the sets of the 8 bits tell every character apart.
+  constexpr auto bits = seq(charset<bit(0)>{}, charset<bit(1)>{}, charset<bit(2)>{}, charset<bit(3)>{},
+                            charset<bit(4)>{}, charset<bit(5)>{}, charset<bit(6)>{}, charset<bit(7)>{});
+  constexpr auto parse = regular(bits);
+
+  static_assert(detail::regular_dfa<std::decay_t<decltype(bits)>>::classes == 256);
+  static_assert(parse("\x01\x02\x04\x08\x10\x20\x40\x80!") == std::make_tuple("\x01\x02\x04\x08\x10\x20\x40\x80", "!"));
+  static_assert(parse("\xff\xff\xff\xff\xff\xff\xff\x7f").has_value() == false);
+
+  CHECK(parse("\xff\xff\xff\xff\xff\xff\xff\xff") == std::make_tuple("\xff\xff\xff\xff\xff\xff\xff\xff", ""));
+  CHECK(parse("\x01\x02\x04\x08\x10\x20\x40\x7f").has_value() == false);
+}
+
+TEST_CASE("regular longest match") {
+  // the grammar stops at the first alternative, the automaton at the longest.
+  constexpr auto keyword = slice(lit<"in">) || slice(lit<"int">);
+  constexpr auto parse = regular(keyword);
+
+  static_assert(keyword("int") == std::make_tuple("in", "t"));
+  static_assert(parse("int") == std::make_tuple("int", ""));
+  static_assert(parse("inx") == std::make_tuple("in", "x"));
+
+  CHECK(keyword("int") == std::make_tuple("in", "t"));
+  CHECK(parse("int") == std::make_tuple("int", ""));
+  CHECK(parse("inx") == std::make_tuple("in", "x"));
+  CHECK(parse("i").has_value() == false);
+}
+
+TEST_CASE("regular timestamp") {
+  constexpr auto d2 = digit + digit;
+  constexpr auto date = seq(d2, d2, skip(one_of<'-'>), d2, skip(one_of<'-'>), d2);
+  constexpr auto time = seq(d2, skip(one_of<':'>), d2, skip(one_of<':'>), d2);
+  constexpr auto fraction = slice(one_of<'.'> + digit + many(digit)) || slice(lit<"">);
+  constexpr auto zone = slice(one_of<'Z'>) || slice(seq(one_of<'+', '-'>, d2, skip(one_of<':'>), d2));
+  constexpr auto timestamp = seq(slice(date), skip(one_of<'T'>), slice(time), fraction, zone);
+  constexpr auto parse = regular(timestamp);
+
+  static_assert(parse("2024-02-29T23:59:60.123+08:00,") == std::make_tuple("2024-02-29T23:59:60.123+08:00", ","));
+  static_assert(parse("2024-02-29T23:59:60Z") == std::make_tuple("2024-02-29T23:59:60Z", ""));
+
+  CHECK(parse("2024-02-29T23:59:60.123+08:00,") == std::make_tuple("2024-02-29T23:59:60.123+08:00", ","));
+  CHECK(parse("2024-02-29T23:59:60Z") == std::make_tuple("2024-02-29T23:59:60Z", ""));
+  CHECK(parse("2024-02-29T23:59:60.Z").has_value() == false);
+  CHECK(parse("2024-02-29 23:59:60Z").has_value() == false);
+
+  CHECK(std::get<1>(timestamp("2024-02-29T23:59:60.5Z").value()) == std::get<1>(parse("2024-02-29T23:59:60.5Z").value()));
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include <doctest/doctest.h>
+#include <parserc/character.h>
+#include <parserc/rule.h>
+#include <parserc/token.h>
+
+#include <stdexcept>
+#include <string>
+
+using namespace parsec;
+
+TEST_CASE("rule") {
+  // nesting := '(' nesting ')' | 'x', the depth of the parentheses.
+  rule<int> nesting;
+  const auto parenthesized = between(one_of<'('>, nesting, one_of<')'>) | map([](int depth) { return depth + 1; });
+  const auto x = one_of<'x'> | map([](char) { return 0; });
+  const auto definition = parenthesized || x;
+
+  CHECK(nesting("x").error().expected == "rule is not defined.");
+  nesting = definition;
+
+  CHECK(nesting("x") == std::make_tuple(0, ""));
+  CHECK(nesting("((x))y") == std::make_tuple(2, "y"));
+  CHECK(nesting("((x)").has_value() == false);
+  CHECK(many(nesting)("x(x)((x))") == std::make_tuple(std::vector<int>{ 0, 1, 2 }, ""));
+
+  // copies refer to the definition of the original.
+  auto copy = nesting;
+  CHECK(copy("(x)") == std::make_tuple(1, ""));
+}
+
+TEST_CASE("rule depth") {
+  rule<int> nesting(100);
+  const auto parenthesized = between(one_of<'('>, nesting, one_of<')'>) | map([](int depth) { return depth + 1; });
+  const auto definition = parenthesized || (one_of<'x'> | map([](char) { return 0; }));
+  nesting = definition;
+
+  auto nested = [](std::size_t depth) {
+    return std::string(depth, '(') + "x" + std::string(depth, ')');
+  };
+  CHECK(nesting(nested(99)) == std::make_tuple(99, ""));
+  CHECK(nesting(nested(100)).has_value() == false);
+
+  // the guard does not overflow the stack on hostile inputs.
+  rule<int> guarded;
+  const auto deep = between(one_of<'('>, guarded, one_of<')'>) | map([](int depth) { return depth + 1; });
+  const auto guarded_definition = deep || (one_of<'x'> | map([](char) { return 0; }));
+  guarded = guarded_definition;
+  auto hostile = std::string(1000000, '(');
+  auto result = guarded(hostile);
+  REQUIRE(result.has_value() == false);
+  CHECK(result.error().offset(hostile) == rule<int>::default_max_depth);
+}
+TEST_CASE("rule depth after exception") {
+  rule<int> nesting(4);
+  const auto parenthesized = between(one_of<'('>, nesting, one_of<')'>) | map([](int depth) { return depth + 1; });
+  const auto leaf = one_of<'x'> | map([](char) { return 0; }) || one_of<'!'> | map([](char) -> int {
+    throw std::runtime_error("leaf");
+  });
+  const auto definition = parenthesized || leaf;
+  nesting = definition;
+
+  // the depth of the rules a throwing parse left is released.
+  for (int i = 0; i < 8; i++) {
+    CHECK_THROWS_AS(nesting("(((!)))"), std::runtime_error);
+  }
+  CHECK(nesting("(((x)))") == std::make_tuple(3, ""));
+}
\ No newline at end of file
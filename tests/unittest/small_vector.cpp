@@ -0,0 +1,83 @@
+#include <doctest/doctest.h>
+#include <parserc/character.h>
+#include <parserc/small_vector.h>
+#include <parserc/token.h>
+
+#include <string>
+
+using namespace parsec;
+
+TEST_CASE("small_vector") {
+  constexpr auto list = [] {
+    small_vector<int, 2> list;
+    list.push_back(1);
+    list.emplace_back(2);
+    bool was_inline = list.is_inline();
+    list.push_back(3);
+    return std::make_tuple(was_inline, list.is_inline(), list.size(), list[0] + list[1] + list.back());
+  }();
+  static_assert(list == std::make_tuple(true, false, 3, 6));
+
+  small_vector<std::string, 2> strings{ "a", "b" };
+  CHECK(strings.is_inline());
+  strings.push_back("c");
+  CHECK(strings.is_inline() == false);
+  CHECK(strings == small_vector<std::string, 2>{ "a", "b", "c" });
+  CHECK(std::string(strings.front()) + strings.back() == "ac");
+
+  strings.clear();
+  CHECK(strings.empty());
+  CHECK(strings.is_inline());
+  CHECK(strings.begin() == strings.end());
+}
+
+TEST_CASE("small_vector own elements") {
+  // an element of the vector itself is copied before the elements move to the heap.
+  small_vector<std::string, 2> strings{ "hello", "world" };
+  strings.push_back(strings.front());
+  CHECK(strings == small_vector<std::string, 2>{ "hello", "world", "hello" });
+  strings.emplace_back(strings.back());
+  CHECK(strings == small_vector<std::string, 2>{ "hello", "world", "hello", "hello" });
+
+  small_vector<std::string, 2> one{ "a" };
+  one.push_back(one[0]);
+  CHECK(one == small_vector<std::string, 2>{ "a", "a" });
+
+  // the vacated inline slots do not keep their strings.
+  std::string long_string(64, 'x');
+  small_vector<std::string, 2> popped{ long_string, long_string };
+  popped.pop_back();
+  CHECK(popped.size() == 1);
+  CHECK(popped.data()[1].empty());
+  popped.clear();
+  CHECK(popped.data()[0].empty());
+
+  static_assert([] {
+    small_vector<int, 2> list{ 1, 2 };
+    list.push_back(list[0]);
+    return list == small_vector<int, 2>{ 1, 2, 1 };
+  }());
+}
+
+TEST_CASE("many<small_vector>") {
+  using chars = small_vector<char, 4>;
+  constexpr auto a = one_of<'a'>;
+  constexpr auto comma = one_of<','>;
+
+  static_assert(many<chars>(a)("aab") == std::make_tuple(chars{ 'a', 'a' }, "b"));
+  static_assert(many<chars>(a)("aaaaaab") == std::make_tuple(chars{ 'a', 'a', 'a', 'a', 'a', 'a' }, "b"));
+  static_assert(many<chars>(a)("b") == std::make_tuple(chars{}, "b"));
+  static_assert(many1<chars>(a)("b").has_value() == false);
+  static_assert(sepby1<chars>(a, comma)("a,a") == std::make_tuple(chars{ 'a', 'a' }, ""));
+  static_assert(sepby<chars>(a, comma)("b") == std::make_tuple(chars{}, "b"));
+  static_assert(first_v<decltype(many1<chars>(a))> == charmap::of('a'));
+
+  CHECK(many<chars>(a)("aab") == std::make_tuple(chars{ 'a', 'a' }, "b"));
+  CHECK(many1<chars>(a)("b").has_value() == false);
+  CHECK(sepby1<chars>(a, comma)("a,a,a,a,a") == std::make_tuple(chars{ 'a', 'a', 'a', 'a', 'a' }, ""));
+  CHECK(sepby<chars>(a, comma)("b") == std::make_tuple(chars{}, "b"));
+
+  // the plain and the fixed forms are unchanged.
+  CHECK(many(a)("aab") == std::make_tuple(std::vector<char>{ 'a', 'a' }, "b"));
+  CHECK(many<2>(a)("aab") == std::make_tuple(std::array<char, 2>{ 'a', 'a' }, "b"));
+}
\ No newline at end of file
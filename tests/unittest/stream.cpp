@@ -0,0 +1,153 @@
+#include <doctest/doctest.h>
+#include <parserc/stream.h>
+#include <parserc/token.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#if __has_include(<sys/socket.h>)
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <thread>
+#endif
+
+using namespace parsec;
+
+namespace {
+
+constexpr auto record = left(decimal<int>, one_of<';'>);
+
+// feeds the input in chunks of the given sizes and collects the records.
+std::vector<int> records(const std::string& input, const std::vector<std::size_t>& sizes) {
+  stream parse(record);
+  std::vector<int> ret;
+  auto push = [&ret](int value) { ret.push_back(value); };
+
+  std::size_t begin = 0;
+  for (std::size_t i = 0; begin < input.size(); i++) {
+    auto size = sizes[i % sizes.size()];
+    auto result = parse.feed(Input(input).substr(begin, size), push);
+    REQUIRE(result.has_value());
+    begin += size;
+    // only the incomplete record is buffered.
+    CHECK(parse.pending().size() < 6);
+  }
+  REQUIRE(parse.finish(push).has_value());
+  CHECK(parse.consumed() == input.size());
+  return ret;
+}
+
+}  // namespace
+
+TEST_CASE("stream") {
+  static_assert([] {
+    stream parse(record);
+    int sum = 0;
+    auto add = [&sum](int value) { sum += value; };
+    return parse.feed("1;2", add) == 1 && parse.feed("3;", add) == 1 && parse.finish(add) == 0 && sum == 24;
+  }());
+
+  std::string input;
+  std::vector<int> expected;
+  std::mt19937 rng(42);
+  for (int i = 0; i < 1000; i++) {
+    expected.push_back(static_cast<int>(rng() % 100000));
+    input += std::to_string(expected.back()) + ";";
+  }
+
+  CHECK(records(input, { input.size() }) == expected);
+  CHECK(records(input, { 1 }) == expected);
+  CHECK(records(input, { 3, 7, 1, 64, 2 }) == expected);
+
+  // records that fail before the end of the bytes fed are errors.
+  stream parse(record);
+  auto ignore = [](int) {};
+  CHECK(parse.feed("12;3", ignore) == 1);
+  CHECK(parse.pending() == "3");
+  auto error = parse.feed("4,5;", ignore);
+  REQUIRE(error.has_value() == false);
+  CHECK(parse.offset(error.error()) == 5);
+
+  // a record cut at the end of the stream is an error.
+  stream cut(record);
+  CHECK(cut.feed("12;34", ignore) == 1);
+  REQUIRE(cut.finish(ignore).has_value() == false);
+}
+
+TEST_CASE("stream tokens") {
+  // literals and keywords cut by a chunk wait for the rest of them.
+  constexpr auto method = left(lit<"GET"> || lit<"PUT">, one_of<';'>);
+  stream methods(method);
+  std::vector<std::string> names;
+  auto name = [&names](std::string_view value) { names.emplace_back(value); };
+  CHECK(methods.feed("GET;GE", name) == 1);
+  CHECK(methods.pending() == "GE");
+  CHECK(methods.feed("T;P", name) == 1);
+  CHECK(methods.feed("UT;", name) == 1);
+  CHECK(methods.finish(name) == 0);
+  CHECK(names == std::vector<std::string>{ "GET", "GET", "PUT" });
+
+  stream verbs(left(keywords<"get", "post", "put">, one_of<';'>));
+  std::vector<std::size_t> indices;
+  auto index = [&indices](std::size_t value) { indices.push_back(value); };
+  CHECK(verbs.feed("put;p", index) == 1);
+  CHECK(verbs.feed("o", index) == 0);
+  CHECK(verbs.pending() == "po");
+  CHECK(verbs.feed("st;get;", index) == 2);
+  CHECK(verbs.finish(index) == 0);
+  CHECK(indices == std::vector<std::size_t>{ 2, 1, 0 });
+
+  // a token that cannot be completed is still an error.
+  stream bad(method);
+  auto error = bad.feed("GET;GEX;", name);
+  REQUIRE(error.has_value() == false);
+  CHECK(bad.offset(error.error()) == 4);
+}
+
+#if __has_include(<sys/socket.h>)
+TEST_CASE("stream socketpair") {
+  int fds[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+  std::string input;
+  long long expected = 0;
+  for (int i = 0; i < 100000; i++) {
+    expected += i;
+    input += std::to_string(i) + ";";
+  }
+
+  std::thread writer([&] {
+    std::mt19937 rng(7);
+    for (std::size_t begin = 0; begin < input.size();) {
+      auto size = std::min<std::size_t>(1 + rng() % 4096, input.size() - begin);
+      auto n = write(fds[0], input.data() + begin, size);
+      REQUIRE(n > 0);
+      begin += static_cast<std::size_t>(n);
+    }
+    close(fds[0]);
+  });
+
+  stream parse(record);
+  long long sum = 0;
+  std::size_t count = 0;
+  std::size_t buffered = 0;
+  auto add = [&](int value) {
+    sum += value;
+    count++;
+  };
+  char chunk[1024];
+  for (ssize_t n; (n = read(fds[1], chunk, sizeof(chunk))) > 0;) {
+    REQUIRE(parse.feed(Input(chunk, static_cast<std::size_t>(n)), add).has_value());
+    buffered = std::max(buffered, parse.pending().size());
+  }
+  REQUIRE(parse.finish(add).has_value());
+  writer.join();
+  close(fds[1]);
+
+  CHECK(count == 100000);
+  CHECK(sum == expected);
+  CHECK(buffered < 6);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include <doctest/doctest.h>
+#include <parserc/token.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+using namespace parsec;
+
+namespace {
+
+// a keyword of every character, which tells all of them apart.
+constexpr auto every_char = [] {
+  fixed_string<257> ret;
+  for (int c = 0; c < 256; c++) {
+    ret.data[c] = static_cast<char>(c);
+  }
+  return ret;
+}();
+
+}  // namespace
+
+TEST_CASE("symbol") {
+  constexpr auto parse = symbol("GET");
+
+  static_assert(parse("GE").has_value() == false);
+  static_assert(parse("GET") == std::make_tuple("GET", ""));
+  static_assert(parse("GET /") == std::make_tuple("GET", " /"));
+
+  CHECK(parse("GE").has_value() == false);
+  CHECK(parse("GET") == std::make_tuple("GET", ""));
+  CHECK(parse("GET /") == std::make_tuple("GET", " /"));
+}
+
+TEST_CASE("keywords") {
+  constexpr auto parse = keywords<"GET", "PUT", "POST", "PATCH", "PATCHES", "">;
+
+  static_assert(parse("GET /") == std::make_tuple(0, " /"));
+  static_assert(parse("POST") == std::make_tuple(2, ""));
+  static_assert(parse("PATCH") == std::make_tuple(3, ""));
+  static_assert(parse("PATCHE") == std::make_tuple(3, "E"));
+  static_assert(parse("PATCHES") == std::make_tuple(4, ""));
+  static_assert(parse("PO") == std::make_tuple(5, "PO"));
+  static_assert(keywords<"GET", "PUT">("PO").has_value() == false);
+  static_assert(keywords<"GET", "PUT">("").has_value() == false);
+  static_assert(keywords<"GET", "GET">("GET") == std::make_tuple(0, ""));
+
+  CHECK(parse("GET /") == std::make_tuple(0, " /"));
+  CHECK(parse("POST") == std::make_tuple(2, ""));
+  CHECK(parse("PATCHE") == std::make_tuple(3, "E"));
+  CHECK(parse("PATCHES") == std::make_tuple(4, ""));
+  CHECK(parse("PO") == std::make_tuple(5, "PO"));
+  CHECK(keywords<"GET", "PUT">("PO").has_value() == false);
+  CHECK(keywords<"GET", "PUT">("").has_value() == false);
+
+  constexpr auto bytes = keywords<every_char, "\xff\x01">;
+  static_assert(bytes(every_char) == std::make_tuple(0, ""));
+  static_assert(bytes("\xff\x01") == std::make_tuple(1, ""));
+  CHECK(bytes("\xff\x01") == std::make_tuple(1, ""));
+}
+
+TEST_CASE("symbols") {
+  constexpr auto parse = symbols<"<", "<=", "<<", "<<=">;
+
+  static_assert(parse("<a") == std::make_tuple("<", "a"));
+  static_assert(parse("<=a") == std::make_tuple("<=", "a"));
+  static_assert(parse("<<a") == std::make_tuple("<<", "a"));
+  static_assert(parse("<<=a") == std::make_tuple("<<=", "a"));
+  static_assert(parse(">").has_value() == false);
+
+  CHECK(parse("<a") == std::make_tuple("<", "a"));
+  CHECK(parse("<=a") == std::make_tuple("<=", "a"));
+  CHECK(parse("<<a") == std::make_tuple("<<", "a"));
+  CHECK(parse("<<=a") == std::make_tuple("<<=", "a"));
+  CHECK(parse(">").has_value() == false);
+}
+
+TEST_CASE("decimal") {
+  static_assert(decimal<uint8_t>("").has_value() == false);
+  static_assert(decimal<uint8_t>("a").has_value() == false);
+  static_assert(decimal<uint8_t>("255a") == std::make_tuple(255, "a"));
+  static_assert(decimal<uint8_t>("256").has_value() == false);
+  static_assert(decimal<uint8_t>("000255") == std::make_tuple(255, ""));
+  static_assert(decimal<uint8_t>("-1").has_value() == false);
+  static_assert(decimal<int8_t>("-128") == std::make_tuple(-128, ""));
+  static_assert(decimal<int8_t>("+127") == std::make_tuple(127, ""));
+  static_assert(decimal<int8_t>("-129").has_value() == false);
+  static_assert(decimal<int8_t>("128").has_value() == false);
+  static_assert(decimal<uint64_t>("18446744073709551615") == std::make_tuple(UINT64_MAX, ""));
+  static_assert(decimal<uint64_t>("18446744073709551616").has_value() == false);
+  static_assert(decimal<int64_t>("-9223372036854775808") == std::make_tuple(INT64_MIN, ""));
+
+  CHECK(decimal<uint8_t>("").has_value() == false);
+  CHECK(decimal<uint8_t>("a").has_value() == false);
+  CHECK(decimal<uint8_t>("255a") == std::make_tuple(255, "a"));
+  CHECK(decimal<uint8_t>("256").has_value() == false);
+  CHECK(decimal<uint8_t>("000255") == std::make_tuple(255, ""));
+  CHECK(decimal<uint8_t>("-1").has_value() == false);
+  CHECK(decimal<int8_t>("-128") == std::make_tuple(-128, ""));
+  CHECK(decimal<int8_t>("+127") == std::make_tuple(127, ""));
+  CHECK(decimal<int8_t>("-129").has_value() == false);
+  CHECK(decimal<int8_t>("128").has_value() == false);
+  CHECK(decimal<uint64_t>("18446744073709551615") == std::make_tuple(UINT64_MAX, ""));
+  CHECK(decimal<uint64_t>("18446744073709551616").has_value() == false);
+  CHECK(decimal<uint64_t>("99999999999999999999").has_value() == false);
+  CHECK(decimal<uint64_t>("19999999999999999999").has_value() == false);
+  CHECK(decimal<uint64_t>("100000000000000000000").has_value() == false);
+  CHECK(decimal<uint64_t>("00000000000000000000000000000001") == std::make_tuple(1, ""));
+  CHECK(decimal<int64_t>("-9223372036854775808") == std::make_tuple(INT64_MIN, ""));
+  CHECK(decimal<int64_t>("9223372036854775808").has_value() == false);
+
+  std::mt19937_64 rng(42);
+  for (int i = 0; i < 10000; i++) {
+    auto value = rng() >> (rng() % 64);
+    auto text = std::to_string(value);
+    CHECK(decimal<uint64_t>(text) == std::make_tuple(value, ""));
+    CHECK(decimal<uint32_t>(text).has_value() == (value <= UINT32_MAX));
+    CHECK(decimal<int64_t>("-" + text).has_value() == (value <= uint64_t{ INT64_MAX } + 1));
+  }
+}
+
+TEST_CASE("octal") {
+  static_assert(octal<uint8_t>("8").has_value() == false);
+  static_assert(octal<uint8_t>("377") == std::make_tuple(0377, ""));
+  static_assert(octal<uint8_t>("400").has_value() == false);
+  static_assert(octal<int8_t>("-200") == std::make_tuple(-128, ""));
+  static_assert(octal<uint64_t>("1777777777777777777777") == std::make_tuple(UINT64_MAX, ""));
+  static_assert(octal<uint64_t>("2000000000000000000000").has_value() == false);
+
+  CHECK(octal<uint8_t>("8").has_value() == false);
+  CHECK(octal<uint8_t>("377") == std::make_tuple(0377, ""));
+  CHECK(octal<uint8_t>("3778") == std::make_tuple(0377, "8"));
+  CHECK(octal<uint8_t>("400").has_value() == false);
+  CHECK(octal<int8_t>("-200") == std::make_tuple(-128, ""));
+  CHECK(octal<uint64_t>("1777777777777777777777") == std::make_tuple(UINT64_MAX, ""));
+  CHECK(octal<uint64_t>("2000000000000000000000").has_value() == false);
+}
+
+TEST_CASE("hexadecimal") {
+  static_assert(hexadecimal<uint8_t>("g").has_value() == false);
+  static_assert(hexadecimal<uint8_t>("fF") == std::make_tuple(0xff, ""));
+  static_assert(hexadecimal<uint8_t>("100").has_value() == false);
+  static_assert(hexadecimal<int16_t>("-8000") == std::make_tuple(-0x8000, ""));
+  static_assert(hexadecimal<uint64_t>("FFFFFFFFFFFFFFFF") == std::make_tuple(UINT64_MAX, ""));
+  static_assert(hexadecimal<uint64_t>("10000000000000000").has_value() == false);
+
+  CHECK(hexadecimal<uint8_t>("g").has_value() == false);
+  CHECK(hexadecimal<uint8_t>("fF") == std::make_tuple(0xff, ""));
+  CHECK(hexadecimal<uint8_t>("fFg") == std::make_tuple(0xff, "g"));
+  CHECK(hexadecimal<uint8_t>("100").has_value() == false);
+  CHECK(hexadecimal<int16_t>("-8000") == std::make_tuple(-0x8000, ""));
+  CHECK(hexadecimal<uint64_t>("0123456789abcdef") == std::make_tuple(0x0123456789abcdef, ""));
+  CHECK(hexadecimal<uint64_t>("FEDCBA9876543210") == std::make_tuple(0xFEDCBA9876543210, ""));
+  CHECK(hexadecimal<uint64_t>("FFFFFFFFFFFFFFFF") == std::make_tuple(UINT64_MAX, ""));
+  CHECK(hexadecimal<uint64_t>("10000000000000000").has_value() == false);
+
+  std::mt19937_64 rng(42);
+  for (int i = 0; i < 10000; i++) {
+    auto value = rng() >> (rng() % 64);
+    char text[16];
+    auto end = std::to_chars(text, text + sizeof(text), value, 16).ptr;
+    CHECK(hexadecimal<uint64_t>(std::string_view(text, end)) == std::make_tuple(value, ""));
+  }
+}
+
+TEST_CASE("floating") {
+  static_assert(floating<double>("").has_value() == false);
+  static_assert(floating<double>(".").has_value() == false);
+  static_assert(floating<double>("-").has_value() == false);
+  static_assert(floating<double>("e5").has_value() == false);
+  static_assert(floating<double>("0") == std::make_tuple(0.0, ""));
+  static_assert(floating<double>("-1.5,") == std::make_tuple(-1.5, ","));
+  static_assert(floating<double>("+.5") == std::make_tuple(0.5, ""));
+  static_assert(floating<double>("5.") == std::make_tuple(5.0, ""));
+  static_assert(floating<double>("1e") == std::make_tuple(1.0, "e"));
+  static_assert(floating<double>("1e+") == std::make_tuple(1.0, "e+"));
+  static_assert(floating<double>("1E-2") == std::make_tuple(0.01, ""));
+  static_assert(floating<double>("0.1") == std::make_tuple(0.1, ""));
+  static_assert(floating<double>("1e23") == std::make_tuple(1e23, ""));
+  static_assert(floating<double>("123456789012345678901234567890") == std::make_tuple(123456789012345678901234567890.0, ""));
+  static_assert(floating<double>("1.7976931348623157e308") == std::make_tuple(1.7976931348623157e308, ""));
+  static_assert(floating<double>("2.2250738585072011e-308") == std::make_tuple(2.2250738585072011e-308, ""));
+  static_assert(floating<double>("4.9406564584124654e-324") == std::make_tuple(4.9406564584124654e-324, ""));
+  static_assert(floating<double>("1e400") == std::make_tuple(std::numeric_limits<double>::infinity(), ""));
+  static_assert(floating<double>("-1e-400") == std::make_tuple(-0.0, ""));
+  static_assert(floating<float>("3.4028235e38") == std::make_tuple(3.4028235e38f, ""));
+  static_assert(floating<float>("1.00000005960464477539062500001") == std::make_tuple(1.0000001f, ""));
+  static_assert(floating<float>("1.4e-45") == std::make_tuple(1.4e-45f, ""));
+  // integer digits past the capacity of the slow path still scale the value.
+  static_assert([] {
+    std::string text = "00123" + std::string(897, '0') + "e-897";
+    return floating<double>(text) == std::make_tuple(123.0, "");
+  }());
+
+  CHECK(floating<double>("").has_value() == false);
+  CHECK(floating<double>(".").has_value() == false);
+  CHECK(floating<double>("-1.5,") == std::make_tuple(-1.5, ","));
+  CHECK(floating<double>("1e") == std::make_tuple(1.0, "e"));
+  CHECK(floating<double>("1e23") == std::make_tuple(1e23, ""));
+  CHECK(floating<double>("1e400") == std::make_tuple(std::numeric_limits<double>::infinity(), ""));
+  CHECK(floating<double>("-1e-400") == std::make_tuple(-0.0, ""));
+  CHECK(floating<float>("1.00000005960464477539062500001") == std::make_tuple(1.0000001f, ""));
+  CHECK(detail::big_decimal("1" + std::string(999, '0'), "5", -998).to_float<double>(false) == 10.0);
+
+  // the runtime and the constant evaluation slow paths agree with strtod.
+  std::mt19937_64 rng(42);
+  for (int i = 0; i < 20000; i++) {
+    auto text = std::to_string(rng() >> (rng() % 64));
+    if (rng() % 2) {
+      text.insert(rng() % text.size(), ".");
+    }
+    text += "e" + std::to_string(static_cast<int>(rng() % 700) - 350);
+
+    auto integer = std::string_view(text).substr(0, text.find_first_of(".e"));
+    auto fraction = std::string_view(text).substr(integer.size());
+    fraction = fraction.starts_with('.') ? fraction.substr(1, fraction.find('e') - 1) : "";
+    auto exponent = std::stoi(text.substr(text.find('e') + 1));
+
+    CHECK(floating<double>(text) == std::make_tuple(std::strtod(text.c_str(), nullptr), ""));
+    CHECK(floating<float>(text) == std::make_tuple(std::strtof(text.c_str(), nullptr), ""));
+    CHECK(detail::big_decimal(integer, fraction, exponent).to_float<double>(false) == std::strtod(text.c_str(), nullptr));
+    CHECK(detail::big_decimal(integer, fraction, exponent).to_float<float>(false) == std::strtof(text.c_str(), nullptr));
+  }
+}
\ No newline at end of file